@@ -0,0 +1,585 @@
+#include "bank.h"
+#include "scaling.h"
+#include "timerwheel.h"
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+_Static_assert(LIVE_STATS_TELLERS == NUM_TELLERS, "The live statistics region must describe every teller");
+
+int quietOutput = 0;
+char lastEvent[BANK_EVENT_SIZE] = "";
+
+/**
+ * Function name: logEvent
+ * Description: Print an event message, or remember it for the dashboard when output is quiet.
+ * Parameters:
+ *** const char *format: printf style format of the message.
+ */
+void logEvent(const char *format, ...) {
+    va_list args;
+    va_start(args, format);
+    if (!quietOutput) {
+        vprintf(format, args);
+    } else {
+        char message[BANK_EVENT_SIZE];
+        int length = 0;
+        vsnprintf(message, sizeof(message), format, args);
+        for (int i = 0; message[i] != '\0'; i++) {
+            if (message[i] != '\n') {
+                lastEvent[length++] = message[i];
+            }
+        }
+        lastEvent[length] = '\0';
+    }
+    va_end(args);
+}
+
+/**
+ * Function name: nextRandom
+ * Description: Draw the next number of the bank's own random sequence (SplitMix64).
+ * Parameters:
+ *** Bank *bank: Pointer to the bank.
+ * Return value:
+ *** unsigned int: A uniformly distributed 31-bit number.
+ */
+static unsigned int nextRandom(Bank *bank) {
+    unsigned long long z = (bank->randomState += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return (unsigned int)((z ^ (z >> 31)) >> 33);
+}
+
+/**
+ * Function name: getRandomDuration
+ * Description: Generate a random duration for the transaction based on the account type.
+ * Parameters:
+ *** Bank *bank: Pointer to the bank, for its duration ranges and random sequence.
+ *** int accountType: The type of account for the transaction.
+ * Return value:
+ *** int: The random duration for the transaction.
+ */
+int getRandomDuration(Bank *bank, int accountType) {
+    if (accountType < 0 || accountType >= NUM_ACCOUNT_TYPES) {
+        return 0; // Should never happen
+    }
+    if (bank->firstDuration[accountType] == BANK_NEVER) {
+        bank->firstDuration[accountType] = bank->totalTimeElapsed;
+    }
+    int min = bank->params.minDuration[accountType];
+    int max = bank->params.maxDuration[accountType];
+    return min + (int)(nextRandom(bank) % (unsigned int)(max - min + 1));
+}
+
+/**
+ * Function name: convertTime
+ * Description: Convert total minutes into hours, minutes, and seconds format.
+ * Parameters:
+ *** int totalTimeElapsed: The total time elapsed in minutes.
+ *** int *hours: Pointer to the hours component.
+ *** int *minutes: Pointer to the minutes component.
+ *** int *seconds: Pointer to the seconds component.
+ */
+void convertTime(int totalTimeElapsed, int *hours, int *minutes, int *seconds) {
+    *hours = totalTimeElapsed / 60;
+    *minutes = totalTimeElapsed % 60;
+    *seconds = 0; // No need to compute seconds from minutes
+}
+
+/**
+ * Function name: ConsolidateTransactions
+ * Description: Consolidate transactions from all stacks into a single stack and display them.
+ * Parameters:
+ *** Stack *completedTransactions: Array of completed transaction stacks for each teller.
+ *** int numTellers: The number of tellers.
+ *** int *tellerTimes: Array to store accumulated transaction times for each teller.
+ *** int *totalTransactions: Array to store total transactions for each teller.
+ */
+void ConsolidateTransactions(Stack *completedTransactions, int numTellers, int *tellerTimes, int *totalTransactions) {
+    Stack consolidatedStack;
+    initStack(&consolidatedStack);
+
+    // Temporary array to store transactions, large enough for every teller stack to be full
+    Transaction *transactions = (Transaction *)malloc(numTellers * MAX_STACK_SIZE * sizeof(Transaction));
+    int count = 0;
+
+    for (int i = 0; i < numTellers; i++) {
+        int drained = drainStack(&completedTransactions[i], transactions + count);
+        count += drained;
+        totalTransactions[i] += drained; // Increment the transaction count for each teller
+    }
+
+    // Sort transactions by stub number
+    for (int i = 0; i < count - 1; i++) {
+        for (int j = i + 1; j < count; j++) {
+            if (transactions[i].stubNumber < transactions[j].stubNumber) {
+                Transaction temp = transactions[i];
+                transactions[i] = transactions[j];
+                transactions[j] = temp;
+            }
+        }
+    }
+
+    // Push sorted transactions back into the stack
+    int pushed = pushBatch(&consolidatedStack, transactions, count);
+    if (pushed < count) {
+        printf("|-[ ! ]- [ Stack is full. Cannot push %d transactions\n", count - pushed);
+    }
+
+    // Display sorted transactions
+    printf("\n|==========================================[ Consolidated Transactions: ]==========================================|\n");
+    while (!isStackEmpty(&consolidatedStack)) {
+        Transaction trans = pop(&consolidatedStack);
+        printf("|-[ ! ]-[ Transaction stub %d, amount %d, account type %s, duration %d minutes\n",
+               trans.stubNumber, trans.amount, accountTypeStr[trans.accountType], trans.duration);
+    }
+
+    // Display total number of transactions and average time for each teller
+    printf("\n|===========================================[ Summary of Transactions ]============================================|\n");
+    for (int i = 0; i < numTellers; i++) {
+        printf("|-[ ! ]-[ Teller %d | Total Transactions: %d, Average Time: %d minutes\n",
+               i + 1, totalTransactions[i],
+               totalTransactions[i] > 0 ? tellerTimes[i] / totalTransactions[i] : 0);
+    }
+
+    free(transactions);
+}
+
+/**
+ * Function name: initBank
+ * Description: Initialize all queues and counters of a bank. Completed transactions are not kept
+ *              until completedTransactions is pointed at NUM_TELLERS stacks.
+ * Parameters:
+ *** Bank *bank: Pointer to the bank to be initialized.
+ */
+void initBank(Bank *bank) {
+    memset(bank, 0, sizeof(*bank));
+    for (int i = 0; i < NUM_TELLERS; i++) {
+        initQueue(&bank->tellers[i]);
+    }
+    initQueue(&bank->pendingQueue);
+    bank->stubNumber = 1;
+    for (int type = 0; type < NUM_ACCOUNT_TYPES; type++) {
+        bank->params.queueLimit[type] = bank->pendingQueue.limits[type];
+        bank->firstDuration[type] = BANK_NEVER;
+        for (int size = 0; size <= MAX_QUEUE_SIZE; size++) {
+            bank->firstLimitCheck[type][size] = BANK_NEVER;
+        }
+    }
+    bank->params.minDuration[NEW] = 8;
+    bank->params.maxDuration[NEW] = 10;
+    bank->params.minDuration[GOVERNMENT] = 10;
+    bank->params.maxDuration[GOVERNMENT] = 15;
+    bank->params.minDuration[CHECKING] = 5;
+    bank->params.maxDuration[CHECKING] = 8;
+    bank->params.minDuration[SAVINGS] = 5;
+    bank->params.maxDuration[SAVINGS] = 7;
+    bank->params.scaling = *findScalingPolicy(NULL);
+}
+
+/**
+ * Function name: seedBank
+ * Description: Start the random sequence of a bank. Banks with the same seed and input run identically.
+ * Parameters:
+ *** Bank *bank: Pointer to the bank.
+ *** unsigned long long seed: The seed.
+ */
+void seedBank(Bank *bank, unsigned long long seed) {
+    bank->randomState = seed;
+}
+
+/**
+ * Function name: setBankParams
+ * Description: Change the run time parameters of a bank, including the limits of all its queues.
+ * Parameters:
+ *** Bank *bank: Pointer to the bank.
+ *** const BankParams *params: The new parameters.
+ */
+void setBankParams(Bank *bank, const BankParams *params) {
+    bank->params = *params;
+    for (int i = 0; i < NUM_TELLERS; i++) {
+        setQueueLimits(&bank->tellers[i], params->queueLimit);
+    }
+    setQueueLimits(&bank->pendingQueue, params->queueLimit);
+}
+
+/**
+ * Function name: copyBank
+ * Description: Make an independent copy of a bank, so that both can be simulated further.
+ *              The completed transaction stacks and the streaming, export and live statistics outputs
+ *              are not shared with the copy.
+ * Parameters:
+ *** Bank *copy: Pointer to the destination, a bank previously copied into or zeroed.
+ *** const Bank *bank: Pointer to the bank to copy.
+ * Return value:
+ *** int: Returns 1 on success, otherwise returns 0.
+ */
+int copyBank(Bank *copy, const Bank *bank) {
+    TimerWheel timeouts = copy->timeouts;
+    if (!copyTimerWheel(&timeouts, &bank->timeouts)) {
+        return 0;
+    }
+    *copy = *bank;
+    copy->timeouts = timeouts;
+    copy->completedTransactions = NULL;
+    copy->stream = NULL;
+    copy->exporter = NULL;
+    copy->live = NULL;
+    return 1;
+}
+
+/**
+ * Function name: freeBank
+ * Description: Release the memory owned by a bank.
+ * Parameters:
+ *** Bank *bank: Pointer to the bank.
+ */
+void freeBank(Bank *bank) {
+    freeTimerWheel(&bank->timeouts);
+}
+
+/**
+ * Function name: noteLimitCheck
+ * Description: Remember the first minute the limit of an account type was consulted at a queue size.
+ * Parameters:
+ *** Bank *bank: Pointer to the bank.
+ *** int accountType: The type of account for the transaction.
+ *** int size: Size of the queue at the time of the check.
+ */
+static void noteLimitCheck(Bank *bank, int accountType, int size) {
+    if (accountType >= 0 && accountType < NUM_ACCOUNT_TYPES && size >= 0 && size <= MAX_QUEUE_SIZE &&
+        bank->firstLimitCheck[accountType][size] == BANK_NEVER) {
+        bank->firstLimitCheck[accountType][size] = bank->totalTimeElapsed;
+    }
+}
+
+/**
+ * Function name: checkQueueFull
+ * Description: Call isQueueFull and remember the first minute each limit was consulted.
+ * Parameters:
+ *** Bank *bank: Pointer to the bank.
+ *** Queue *q: Pointer to the queue.
+ *** int accountType: The type of account for the transaction.
+ * Return value:
+ *** int: Returns 1 if the queue is full, otherwise returns 0.
+ */
+static int checkQueueFull(Bank *bank, Queue *q, int accountType) {
+    noteLimitCheck(bank, accountType, q->size);
+    return isQueueFull(q, accountType);
+}
+
+/**
+ * Function name: getPatience
+ * Description: Get how long a customer of the given account type is willing to wait.
+ * Parameters:
+ *** int accountType: The type of account for the transaction.
+ * Return value:
+ *** int: The patience in minutes.
+ */
+int getPatience(int accountType) {
+    switch (accountType) {
+        case NEW:
+            return PATIENCE_NEW;
+        case GOVERNMENT:
+            return PATIENCE_GOV;
+        case CHECKING:
+            return PATIENCE_CHECKING;
+        case SAVINGS:
+            return PATIENCE_SAVINGS;
+        default:
+            return 0; // Should never happen
+    }
+}
+
+/**
+ * Function name: averageServiceTime
+ * Description: Estimate the service time of the next customer from the transactions completed so far.
+ * Parameters:
+ *** Bank *bank: Pointer to the bank.
+ * Return value:
+ *** double: The average service time in minutes.
+ */
+static double averageServiceTime(Bank *bank) {
+    int completed = 0;
+    int busyTime = 0;
+    for (int i = 0; i < NUM_TELLERS; i++) {
+        completed += bank->completedCount[i];
+        busyTime += bank->tellerTimes[i];
+    }
+    return completed > 0 ? (double)busyTime / completed : SCALING_DEFAULT_SERVICE_TIME;
+}
+
+/**
+ * Function name: enableAbandonment
+ * Description: Let customers balk on arrival and renege once their patience runs out.
+ * Parameters:
+ *** Bank *bank: Pointer to the bank.
+ * Return value:
+ *** int: Returns 1 on success, otherwise returns 0.
+ */
+int enableAbandonment(Bank *bank) {
+    if (!initTimerWheel(&bank->timeouts, bank->totalTimeElapsed)) {
+        return 0;
+    }
+    bank->abandonment = 1;
+    return 1;
+}
+
+/**
+ * Function name: onPatienceExpired
+ * Description: Timing wheel callback that removes a customer who waited too long from its queue.
+ * Parameters:
+ *** void *context: Pointer to the bank.
+ *** int stubNumber: Stub number of the customer.
+ */
+static void onPatienceExpired(void *context, int stubNumber) {
+    Bank *bank = (Bank *)context;
+    Transaction removed;
+    for (int i = 0; i <= NUM_TELLERS; i++) {
+        Queue *q = i < NUM_TELLERS ? &bank->tellers[i] : &bank->pendingQueue;
+        if (removeFromQueue(q, stubNumber, &removed)) {
+            bank->reneged[removed.accountType]++;
+            logEvent("|-[ ! ]- [ Customer with stub %d left after waiting %d minutes.\n",
+                     stubNumber, bank->totalTimeElapsed - removed.arrivalTime);
+            return;
+        }
+    }
+}
+
+/**
+ * Function name: printAbandonment
+ * Description: Display how many customers of each account type balked or reneged.
+ * Parameters:
+ *** Bank *bank: Pointer to the bank.
+ */
+void printAbandonment(Bank *bank) {
+    printf("\n|==============================================[ Abandoned Customers ]=============================================|\n");
+    for (int i = 0; i < NUM_ACCOUNT_TYPES; i++) {
+        printf("|-[ ! ]-[ %-10s | Patience: %d minutes, Left Without Queueing: %d, Left While Waiting: %d\n",
+               accountTypeStr[i], getPatience(i), bank->balked[i], bank->reneged[i]);
+    }
+}
+
+/**
+ * Function name: addCustomer
+ * Description: Create a transaction for an arriving customer and place it in a teller queue,
+ *              the pending queue or the extra queue.
+ * Parameters:
+ *** Bank *bank: Pointer to the bank.
+ *** int amount: The amount of the transaction.
+ *** int accountType: The type of account for the transaction.
+ * Return value:
+ *** int: The stub number given to the customer, or -1 if the transaction could not be queued.
+ */
+int addCustomer(Bank *bank, int amount, int accountType) {
+    Queue *tellers = bank->tellers;
+    Transaction transaction;
+    transaction.stubNumber = bank->stubNumber++; // Automatically assign a stub number
+    transaction.amount = amount;
+    transaction.accountType = accountType;
+    transaction.duration = getRandomDuration(bank, transaction.accountType);
+    transaction.arrivalTime = bank->totalTimeElapsed;
+    transaction.timerHandle = -1;
+
+    int tellerIndex = -1;
+    if (transaction.accountType == NEW || transaction.accountType == GOVERNMENT) {
+        tellerIndex = transaction.accountType; // New and Government accounts have dedicated queues
+    } else if (transaction.accountType == CHECKING || transaction.accountType == SAVINGS) {
+        // Distribute evenly among the available tellers
+        tellerIndex = 2 + (transaction.accountType == CHECKING ? 0 : 1);
+    } else {
+        bank->invalid++;
+        logEvent("|-[ ! ]- [ Invalid account type. Transaction ignored.\n");
+        return -1;
+    }
+
+    // Every queue, including the 5th teller and the pending queue, enforces the per-type limits,
+    // so a customer who fits nowhere is rejected instead of growing the pending queue past them
+    Queue *destination;
+    if (!checkQueueFull(bank, &tellers[tellerIndex], transaction.accountType)) {
+        destination = &tellers[tellerIndex];
+    } else if (bank->extraState == TELLER_OPEN && isQueueEmpty(&bank->pendingQueue) &&
+               tellers[EXTRA_TELLER].size < MAX_EXTRA_QUEUE_TRANSACTIONS &&
+               !checkQueueFull(bank, &tellers[EXTRA_TELLER], transaction.accountType)) {
+        // Send overflow to the extra teller while it is open, keeping older pending customers ahead
+        destination = &tellers[EXTRA_TELLER];
+    } else if (!checkQueueFull(bank, &bank->pendingQueue, transaction.accountType)) {
+        destination = &bank->pendingQueue;
+    } else {
+        bank->rejected++;
+        logEvent("|-[ ! ]- [ Pending queue is full. Cannot enqueue transaction %d\n", transaction.amount);
+        return -1;
+    }
+
+    if (bank->abandonment) {
+        // Customers who expect to wait longer than their patience leave right away
+        int patience = getPatience(transaction.accountType);
+        if ((destination->size + 1) * averageServiceTime(bank) > patience) {
+            bank->balked[transaction.accountType]++;
+            logEvent("|-[ ! ]- [ Customer with stub %d left without queueing.\n", transaction.stubNumber);
+            return -1;
+        }
+        transaction.timerHandle = addTimer(&bank->timeouts, transaction.arrivalTime + patience, transaction.stubNumber);
+    }
+
+    enqueue(destination, transaction);
+    bank->admitted++;
+    if (destination == &bank->pendingQueue) {
+        logEvent("|-[ ! ]- [ Transaction enqueued to pending queue.\n");
+    }
+    return transaction.stubNumber;
+}
+
+/**
+ * Function name: migratePending
+ * Description: Move customers from the front of the pending queue to the extra teller while it has room.
+ *              Customers keep their order, so nobody is overtaken by someone who arrived later.
+ * Parameters:
+ *** Bank *bank: Pointer to the bank.
+ */
+static void migratePending(Bank *bank) {
+    Queue *extra = &bank->tellers[EXTRA_TELLER];
+    Queue *pending = &bank->pendingQueue;
+    Transaction moving[MAX_EXTRA_QUEUE_TRANSACTIONS];
+
+    int size = extra->size;
+    int count = peekBatch(pending, moving, MAX_EXTRA_QUEUE_TRANSACTIONS - size);
+    int accepted = enqueueBatch(extra, moving, count);
+
+    // The limits consulted are those of every customer moved and of the one that did not fit
+    for (int k = 0; k < count && k <= accepted; k++) {
+        noteLimitCheck(bank, moving[k].accountType, size + k);
+    }
+    dequeueBatch(pending, moving, accepted);
+}
+
+/**
+ * Function name: scaleTellers
+ * Description: Refresh the scaling signals, ask the scaling policy whether the extra teller
+ *              should open or close, and move waiting customers to it while it is open.
+ * Parameters:
+ *** Bank *bank: Pointer to the bank.
+ */
+void scaleTellers(Bank *bank) {
+    ScalingSignals *signals = &bank->signals;
+    int openTellers = NUM_TELLERS - (bank->extraState == TELLER_CLOSED ? 1 : 0);
+
+    signals->pendingSize = bank->pendingQueue.size;
+    signals->depth = bank->pendingQueue.size;
+    for (int i = 0; i < EXTRA_TELLER; i++) {
+        signals->depth += bank->tellers[i].size;
+    }
+    signals->regularFull = checkQueueFull(bank, &bank->tellers[2], CHECKING) && checkQueueFull(bank, &bank->tellers[3], SAVINGS);
+    signals->smoothedDepth += bank->params.scaling.smoothing * (signals->depth - signals->smoothedDepth);
+
+    signals->predictedWait = signals->smoothedDepth * averageServiceTime(bank) / openTellers;
+    signals->extraState = bank->extraState;
+    signals->openTime = bank->extraState == TELLER_CLOSED ? 0 : bank->totalTimeElapsed - bank->extraOpenedAt;
+
+    int decision = bank->params.scaling.decide(&bank->params.scaling, signals);
+    if (decision == SCALE_OPEN && bank->extraState != TELLER_OPEN) {
+        logEvent("|-[ ! ]-[ Opening 5th queue, predicted wait %.0f minutes.\n", signals->predictedWait);
+        if (bank->extraState == TELLER_CLOSED) {
+            bank->extraOpenedAt = bank->totalTimeElapsed;
+        }
+        bank->extraState = TELLER_OPEN;
+    } else if (decision == SCALE_CLOSE && bank->extraState == TELLER_OPEN) {
+        logEvent("|-[ ! ]-[ Draining 5th queue, predicted wait %.0f minutes.\n", signals->predictedWait);
+        bank->extraState = TELLER_DRAINING;
+    }
+
+    if (bank->extraState == TELLER_OPEN) {
+        migratePending(bank);
+    } else if (bank->extraState == TELLER_DRAINING && isQueueEmpty(&bank->tellers[EXTRA_TELLER]) &&
+               !bank->isBusy[EXTRA_TELLER]) {
+        logEvent("|-[ ! ]-[ Closing 5th queue.\n");
+        bank->extraState = TELLER_CLOSED;
+    }
+}
+
+/**
+ * Function name: publishLiveStats
+ * Description: Copy the teller status, queue depths and counters into the shared memory region.
+ * Parameters:
+ *** Bank *bank: Pointer to the bank, its live field must be set.
+ */
+void publishLiveStats(Bank *bank) {
+    LiveSnapshot *snapshot = beginLiveUpdate(bank->live);
+    snapshot->time = bank->totalTimeElapsed;
+    snapshot->running = 1;
+    snapshot->pendingSize = bank->pendingQueue.size;
+    snapshot->extraState = bank->extraState;
+    snapshot->predictedWait = bank->signals.predictedWait;
+    snapshot->nextStub = bank->stubNumber;
+    for (int i = 0; i < NUM_TELLERS; i++) {
+        snapshot->isBusy[i] = bank->isBusy[i];
+        snapshot->remainingTime[i] = bank->isBusy[i] ? bank->remainingTime[i] : 0;
+        snapshot->currentStub[i] = bank->isBusy[i] ? bank->currentTransaction[i].stubNumber : 0;
+        snapshot->queueSize[i] = bank->tellers[i].size;
+        snapshot->completedCount[i] = bank->completedCount[i];
+        snapshot->busyTime[i] = bank->tellerTimes[i];
+    }
+    memcpy(snapshot->balked, bank->balked, sizeof(snapshot->balked));
+    memcpy(snapshot->reneged, bank->reneged, sizeof(snapshot->reneged));
+    endLiveUpdate(bank->live);
+}
+
+/**
+ * Function name: tickBank
+ * Description: Advance the simulation by one minute, letting every teller work on its queue.
+ * Parameters:
+ *** Bank *bank: Pointer to the bank.
+ */
+void tickBank(Bank *bank) {
+    if (bank->abandonment) {
+        advanceTimerWheel(&bank->timeouts, bank->totalTimeElapsed, onPatienceExpired, bank);
+    }
+    scaleTellers(bank);
+
+    // Idle tellers call their next customer
+    for (int i = 0; i < NUM_TELLERS; i++) {
+        Queue *q = &bank->tellers[i];
+        if (!bank->isBusy[i] && !isQueueEmpty(q)) {
+            if (bank->abandonment) {
+                cancelTimer(&bank->timeouts, q->transactions[q->front].timerHandle); // About to be served
+            }
+            bank->currentTransaction[i] = dequeue(q);
+            bank->totalWait += bank->totalTimeElapsed - bank->currentTransaction[i].arrivalTime;
+            bank->remainingTime[i] = bank->currentTransaction[i].duration;
+            bank->isBusy[i] = 1;
+        }
+    }
+
+    // Every busy teller works one minute
+    unsigned int completedMask[TELLER_MASK_WORDS(NUM_TELLERS)];
+    updateTellers(bank->remainingTime, bank->isBusy, bank->tellerTimes, NUM_TELLERS, completedMask);
+
+    // Hand the finished transactions on, in teller order
+    int i;
+    while ((i = nextCompletedTeller(completedMask, TELLER_MASK_WORDS(NUM_TELLERS))) >= 0) {
+        Transaction *done = &bank->currentTransaction[i];
+        CompletionRecord record = { *done, i, bank->totalTimeElapsed };
+        if (bank->completedTransactions != NULL) {
+            // Checked here rather than left to push, so the message goes through logEvent like every other
+            if (isStackFull(&bank->completedTransactions[i])) {
+                logEvent("|-[ ! ]- [ Stack is full. Cannot push transaction %d\n", done->amount);
+            } else {
+                push(&bank->completedTransactions[i], *done);
+            }
+        }
+        logEvent("\n|-[ ! ]-[ Completed Transaction: Stub %d, Amount: %d, %s Account, Duration: %d minutes\n",
+                 done->stubNumber, done->amount, accountTypeStr[done->accountType], done->duration);
+        bank->completedCount[i]++;
+        if (bank->stream != NULL) {
+            recordCompletion(bank->stream, record);
+        }
+        if (bank->exporter != NULL) {
+            exportCompletion(bank->exporter, &record);
+        }
+    }
+    bank->totalTimeElapsed += 1;
+    if (bank->live != NULL) {
+        publishLiveStats(bank);
+    }
+}
@@ -0,0 +1,92 @@
+#ifndef BANK_H
+#define BANK_H
+
+#include "export.h"
+#include "livestats.h"
+#include "queue.h"
+#include "scaling.h"
+#include "stack.h"
+#include "tellerkernel.h"
+#include "timerwheel.h"
+#include "streamstats.h"
+#include "transaction.h"
+
+#define MAX_EXTRA_QUEUE_TRANSACTIONS 10
+#define NUM_TELLERS 5
+#define BANK_EVENT_SIZE 120
+
+// Define how many minutes customers of each account type are willing to wait
+#define PATIENCE_NEW 45
+#define PATIENCE_GOV 60
+#define PATIENCE_CHECKING 30
+#define PATIENCE_SAVINGS 30
+
+// Marks a minute that has not happened yet
+#define BANK_NEVER -1
+
+// Define the parameters of a simulation that can be changed at run time
+typedef struct {
+    int queueLimit[NUM_ACCOUNT_TYPES];   // Queue size from which isQueueFull reports full, per account type
+    int minDuration[NUM_ACCOUNT_TYPES];  // Range of getRandomDuration per account type
+    int maxDuration[NUM_ACCOUNT_TYPES];
+    ScalingPolicy scaling;               // Decides when the extra teller opens and closes
+} BankParams;
+
+// Define the complete state of one bank simulation
+typedef struct {
+    Queue tellers[NUM_TELLERS];
+    Stack *completedTransactions;        // One stack of completed transactions per teller, or NULL when they are not kept
+    Queue pendingQueue;
+    // Teller state as separate arrays so that updateTellers can work on all tellers at once
+    Transaction currentTransaction[NUM_TELLERS];
+    int isBusy[NUM_TELLERS];
+    int remainingTime[NUM_TELLERS];
+    int tellerTimes[NUM_TELLERS];        // Accumulated transaction times for each teller
+    int totalTransactions[NUM_TELLERS];  // Transactions counted by ConsolidateTransactions
+    int completedCount[NUM_TELLERS];     // Transactions completed by each teller so far
+    int totalTimeElapsed;
+    int stubNumber;                      // Stub number given to the next customer
+    StreamStats *stream;                 // Streaming statistics, or NULL when not streaming
+    Exporter *exporter;                  // Completion history export, or NULL when not exporting
+    LiveStats *live;                     // Shared memory view for monitors, or NULL when not publishing
+    BankParams params;
+    unsigned long long randomState;      // Random number generator, so that a copied bank replays identically
+    ScalingSignals signals;              // Inputs of the last scaling decision
+    int extraState;                      // TELLER_CLOSED, TELLER_OPEN or TELLER_DRAINING
+    int extraOpenedAt;                   // Minute the extra teller was last opened
+    int abandonment;                     // Customers balk and renege when set
+    TimerWheel timeouts;                 // Patience timers of the waiting customers
+    int balked[NUM_ACCOUNT_TYPES];       // Customers who left without queueing
+    int reneged[NUM_ACCOUNT_TYPES];      // Customers who left while waiting
+    int admitted;                        // Customers who joined a queue
+    int rejected;                        // Customers turned away because every queue was full
+    int invalid;                         // Arrivals ignored because of an unknown account type
+    long long totalWait;                 // Minutes the served customers waited before a teller called them
+    // First minute each parameter was consulted, to know from when a changed value can make a difference
+    int firstLimitCheck[NUM_ACCOUNT_TYPES][MAX_QUEUE_SIZE + 1]; // Per account type and queue size
+    int firstDuration[NUM_ACCOUNT_TYPES];
+} Bank;
+
+// While the dashboard or server owns the terminal, event messages are kept instead of printed
+extern int quietOutput;
+extern char lastEvent[BANK_EVENT_SIZE];
+
+// Function declarations
+void logEvent(const char *format, ...);
+int getRandomDuration(Bank *bank, int accountType);
+void convertTime(int totalTimeElapsed, int *hours, int *minutes, int *seconds);
+void ConsolidateTransactions(Stack *completedTransactions, int numTellers, int *tellerTimes, int *totalTransactions);
+void initBank(Bank *bank);
+void seedBank(Bank *bank, unsigned long long seed);
+void setBankParams(Bank *bank, const BankParams *params);
+int copyBank(Bank *copy, const Bank *bank);
+void freeBank(Bank *bank);
+int getPatience(int accountType);
+int enableAbandonment(Bank *bank);
+void printAbandonment(Bank *bank);
+int addCustomer(Bank *bank, int amount, int accountType);
+void scaleTellers(Bank *bank);
+void publishLiveStats(Bank *bank);
+void tickBank(Bank *bank);
+
+#endif // BANK_H
@@ -0,0 +1,176 @@
+#include "dashboard.h"
+#include <stdarg.h>
+#include <string.h>
+#include <sys/ioctl.h>
+#include <time.h>
+#include <unistd.h>
+
+/**
+ * Function name: monotonicSeconds
+ * Description: Read the monotonic wall clock.
+ * Return value:
+ *** double: The current time in seconds.
+ */
+static double monotonicSeconds(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec + now.tv_nsec / 1e9;
+}
+
+/**
+ * Function name: initDashboard
+ * Description: Initialize a dashboard with a capped refresh rate.
+ * Parameters:
+ *** Dashboard *d: Pointer to the dashboard to be initialized.
+ *** FILE *out: Terminal stream the dashboard is drawn on.
+ *** int fps: Maximum number of redraws per second, 0 or less to use the default.
+ */
+void initDashboard(Dashboard *d, FILE *out, int fps) {
+    memset(d, 0, sizeof(*d));
+    d->out = out;
+    d->needsClear = 1;
+    d->minInterval = 1.0 / (fps > 0 ? fps : DASHBOARD_DEFAULT_FPS);
+    d->lastDraw = -d->minInterval;
+}
+
+/**
+ * Function name: beginFrame
+ * Description: Start building a new frame. Lines are added with frameLine.
+ * Parameters:
+ *** Dashboard *d: Pointer to the dashboard.
+ */
+void beginFrame(Dashboard *d) {
+    d->currentCount = 0;
+}
+
+/**
+ * Function name: frameLine
+ * Description: Append a formatted line to the frame being built. Long lines are truncated.
+ * Parameters:
+ *** Dashboard *d: Pointer to the dashboard.
+ *** const char *format: printf style format of the line.
+ */
+void frameLine(Dashboard *d, const char *format, ...) {
+    if (d->currentCount == DASHBOARD_MAX_LINES) {
+        return;
+    }
+    va_list args;
+    va_start(args, format);
+    vsnprintf(d->current[d->currentCount++], DASHBOARD_LINE_SIZE, format, args);
+    va_end(args);
+}
+
+/**
+ * Function name: terminalRows
+ * Description: Ask the terminal how many rows it shows.
+ * Parameters:
+ *** Dashboard *d: Pointer to the dashboard.
+ * Return value:
+ *** int: The number of rows, or one more than the largest frame when the size is unknown.
+ */
+static int terminalRows(Dashboard *d) {
+    struct winsize size;
+    if (ioctl(fileno(d->out), TIOCGWINSZ, &size) == 0 && size.ws_row > 0) {
+        return size.ws_row;
+    }
+    return DASHBOARD_MAX_LINES + 1;
+}
+
+/**
+ * Function name: renderDashboard
+ * Description: Draw the current frame, rewriting only the part of each line that changed
+ *              since the previous frame. Redraws are skipped while the refresh interval has not passed.
+ * Parameters:
+ *** Dashboard *d: Pointer to the dashboard.
+ *** int force: Draw even if the refresh interval has not passed.
+ * Return value:
+ *** int: Returns 1 if the frame was drawn, otherwise returns 0.
+ */
+int renderDashboard(Dashboard *d, int force) {
+    double now = monotonicSeconds();
+    if (!force && now - d->lastDraw < d->minInterval) {
+        return 0;
+    }
+    d->lastDraw = now;
+
+    if (d->needsClear == DASHBOARD_SCROLL) {
+        // Push everything on screen into the scrollback, then draw from the top of the now empty screen
+        for (int row = terminalRows(d); row > 0; row--) {
+            fputc('\n', d->out);
+        }
+        d->previousCount = 0;
+        d->needsClear = 0;
+    } else if (d->needsClear) {
+        fputs("\033[2J", d->out);
+        d->previousCount = 0;
+        d->needsClear = 0;
+    }
+
+    for (int row = 0; row < d->currentCount; row++) {
+        const char *line = d->current[row];
+        int column = 0;
+        if (row < d->previousCount) {
+            const char *old = d->previous[row];
+            while (line[column] != '\0' && line[column] == old[column]) {
+                column++;
+            }
+            if (line[column] == old[column]) {
+                continue; // Line is unchanged
+            }
+        }
+        // Move to the first changed column, write the rest of the line and clear what is left of the old one
+        fprintf(d->out, "\033[%d;%dH%s\033[K", row + 1, column + 1, line + column);
+        memcpy(d->previous[row], line, strlen(line) + 1);
+    }
+    for (int row = d->currentCount; row < d->previousCount; row++) {
+        fprintf(d->out, "\033[%d;1H\033[K", row + 1);
+    }
+    d->previousCount = d->currentCount;
+    fflush(d->out);
+    return 1;
+}
+
+/**
+ * Function name: invalidateDashboard
+ * Description: Force the next render to clear the screen and redraw every line,
+ *              for example after other output was written to the terminal.
+ * Parameters:
+ *** Dashboard *d: Pointer to the dashboard.
+ */
+void invalidateDashboard(Dashboard *d) {
+    d->needsClear = 1;
+}
+
+/**
+ * Function name: scrollDashboard
+ * Description: Force the next render to redraw every line like invalidateDashboard, but scroll the
+ *              output written meanwhile into the terminal's scrollback instead of erasing it.
+ * Parameters:
+ *** Dashboard *d: Pointer to the dashboard.
+ */
+void scrollDashboard(Dashboard *d) {
+    d->needsClear = DASHBOARD_SCROLL;
+}
+
+/**
+ * Function name: dashboardPrompt
+ * Description: Show a prompt on the line below the frame.
+ * Parameters:
+ *** Dashboard *d: Pointer to the dashboard.
+ *** const char *text: The prompt text.
+ */
+void dashboardPrompt(Dashboard *d, const char *text) {
+    fprintf(d->out, "\033[%d;1H\033[K%s", d->previousCount + 1, text);
+    fflush(d->out);
+}
+
+/**
+ * Function name: leaveDashboard
+ * Description: Move the cursor below the frame so normal output can continue.
+ * Parameters:
+ *** Dashboard *d: Pointer to the dashboard.
+ */
+void leaveDashboard(Dashboard *d) {
+    fprintf(d->out, "\033[%d;1H\033[K\n", d->previousCount + 1);
+    fflush(d->out);
+}
@@ -0,0 +1,34 @@
+#ifndef DASHBOARD_H
+#define DASHBOARD_H
+
+#include <stdio.h>
+
+// Define the frame size and the default refresh rate
+#define DASHBOARD_MAX_LINES 48
+#define DASHBOARD_LINE_SIZE 120
+#define DASHBOARD_DEFAULT_FPS 10
+#define DASHBOARD_SCROLL 2 // needsClear value that scrolls the screen instead of erasing it
+
+// Define a Dashboard that remembers the last frame written to the terminal
+typedef struct {
+    char previous[DASHBOARD_MAX_LINES][DASHBOARD_LINE_SIZE];
+    char current[DASHBOARD_MAX_LINES][DASHBOARD_LINE_SIZE];
+    int previousCount;
+    int currentCount;
+    int needsClear;       // Set when the screen content is unknown and must be redrawn in full, see DASHBOARD_SCROLL
+    double minInterval;   // Minimum number of seconds between two redraws
+    double lastDraw;
+    FILE *out;
+} Dashboard;
+
+// Function declarations
+void initDashboard(Dashboard *d, FILE *out, int fps);
+void beginFrame(Dashboard *d);
+void frameLine(Dashboard *d, const char *format, ...);
+int renderDashboard(Dashboard *d, int force);
+void invalidateDashboard(Dashboard *d);
+void scrollDashboard(Dashboard *d);
+void dashboardPrompt(Dashboard *d, const char *text);
+void leaveDashboard(Dashboard *d);
+
+#endif // DASHBOARD_H
@@ -0,0 +1,99 @@
+#include "encoding.h"
+
+/**
+ * Function name: zigzagEncode
+ * Description: Map a signed value to an unsigned one so that small negative numbers stay small.
+ * Parameters:
+ *** long long value: The signed value to encode.
+ * Return value:
+ *** unsigned long long: The zigzag encoded value.
+ */
+unsigned long long zigzagEncode(long long value) {
+    return ((unsigned long long)value << 1) ^ (unsigned long long)(value >> 63);
+}
+
+/**
+ * Function name: zigzagDecode
+ * Description: Reverse the mapping done by zigzagEncode.
+ * Parameters:
+ *** unsigned long long value: The zigzag encoded value.
+ * Return value:
+ *** long long: The original signed value.
+ */
+long long zigzagDecode(unsigned long long value) {
+    return (long long)(value >> 1) ^ -(long long)(value & 1);
+}
+
+/**
+ * Function name: putVarint
+ * Description: Write a value as a little-endian base-128 varint.
+ * Parameters:
+ *** unsigned char *buffer: Destination buffer, must have room for MAX_VARINT_BYTES.
+ *** unsigned long long value: The value to write.
+ * Return value:
+ *** int: The number of bytes written.
+ */
+int putVarint(unsigned char *buffer, unsigned long long value) {
+    int count = 0;
+    while (value >= 0x80) {
+        buffer[count++] = (unsigned char)(value | 0x80);
+        value >>= 7;
+    }
+    buffer[count++] = (unsigned char)value;
+    return count;
+}
+
+/**
+ * Function name: getVarint
+ * Description: Read a varint written by putVarint.
+ * Parameters:
+ *** const unsigned char *buffer: Source buffer.
+ *** int length: Number of bytes available in the buffer.
+ *** unsigned long long *value: Pointer to store the decoded value.
+ * Return value:
+ *** int: The number of bytes consumed, or 0 if the varint is truncated or malformed.
+ */
+int getVarint(const unsigned char *buffer, int length, unsigned long long *value) {
+    unsigned long long result = 0;
+    int shift = 0;
+    for (int i = 0; i < length && i < MAX_VARINT_BYTES; i++) {
+        result |= (unsigned long long)(buffer[i] & 0x7F) << shift;
+        if (!(buffer[i] & 0x80)) {
+            *value = result;
+            return i + 1;
+        }
+        shift += 7;
+    }
+    return 0;
+}
+
+/**
+ * Function name: crc32
+ * Description: Compute the CRC-32 (IEEE 802.3) checksum of a buffer.
+ * Parameters:
+ *** const unsigned char *buffer: The data to checksum.
+ *** int length: Number of bytes in the buffer.
+ * Return value:
+ *** unsigned int: The checksum.
+ */
+unsigned int crc32(const unsigned char *buffer, int length) {
+    static unsigned int table[256];
+    static int tableReady = 0;
+
+    if (!tableReady) {
+        for (unsigned int i = 0; i < 256; i++) {
+            unsigned int value = i;
+            for (int bit = 0; bit < 8; bit++) {
+                value = (value & 1) ? 0xEDB88320u ^ (value >> 1) : value >> 1;
+            }
+            table[i] = value;
+        }
+        tableReady = 1;
+    }
+
+    unsigned int crc = 0xFFFFFFFFu;
+    for (int i = 0; i < length; i++) {
+        crc = table[(crc ^ buffer[i]) & 0xFF] ^ (crc >> 8);
+    }
+    return crc ^ 0xFFFFFFFFu;
+}
@@ -0,0 +1,14 @@
+#ifndef ENCODING_H
+#define ENCODING_H
+
+// Maximum number of bytes a 64-bit varint can occupy
+#define MAX_VARINT_BYTES 10
+
+// Function declarations
+unsigned long long zigzagEncode(long long value);
+long long zigzagDecode(unsigned long long value);
+int putVarint(unsigned char *buffer, unsigned long long value);
+int getVarint(const unsigned char *buffer, int length, unsigned long long *value);
+unsigned int crc32(const unsigned char *buffer, int length);
+
+#endif // ENCODING_H
@@ -0,0 +1,498 @@
+#include "export.h"
+#include <string.h>
+
+#define EXPORT_MAGIC "CCDX"
+#define EXPORT_VERSION 2 // Version 1 stored duration as FIXED8, clamped to 255
+#define CSV_MAX_ROW 128
+
+// Define the name and encoding of every column, in file order
+static const struct {
+    int id;
+    int encoding;
+    const char *name;
+} columns[EXPORT_NUM_COLUMNS] = {
+    { COLUMN_STUB, ENCODING_DELTA_VARINT, "stub" },
+    { COLUMN_AMOUNT, ENCODING_VARINT, "amount" },
+    { COLUMN_ACCOUNT_TYPE, ENCODING_PACKED2, "account_type" },
+    { COLUMN_DURATION, ENCODING_VARINT, "duration" }, // What-if duration ranges go well past one byte
+    { COLUMN_TELLER, ENCODING_FIXED8, "teller" },
+    { COLUMN_ARRIVAL_TIME, ENCODING_DELTA_VARINT, "arrival_time" },
+    { COLUMN_START_TIME, ENCODING_DELTA_VARINT, "start_time" },
+    { COLUMN_COMPLETED_AT, ENCODING_DELTA_VARINT, "completed_at" },
+};
+
+/**
+ * Function name: columnValue
+ * Description: Get the value of one column for a completed transaction.
+ * Parameters:
+ *** const CompletionRecord *record: Pointer to the completion record.
+ *** int column: The column id.
+ * Return value:
+ *** long long: The column value.
+ */
+static long long columnValue(const CompletionRecord *record, int column) {
+    switch (column) {
+        case COLUMN_STUB:
+            return record->transaction.stubNumber;
+        case COLUMN_AMOUNT:
+            return record->transaction.amount;
+        case COLUMN_ACCOUNT_TYPE:
+            return record->transaction.accountType;
+        case COLUMN_DURATION:
+            return record->transaction.duration;
+        case COLUMN_TELLER:
+            return record->teller;
+        case COLUMN_ARRIVAL_TIME:
+            return record->transaction.arrivalTime;
+        case COLUMN_START_TIME:
+            // The teller works on the transaction during the minutes start_time to completed_at
+            return record->completedAt - record->transaction.duration + 1;
+        case COLUMN_COMPLETED_AT:
+            return record->completedAt;
+        default:
+            return 0; // Should never happen
+    }
+}
+
+/**
+ * Function name: putLittleEndian
+ * Description: Write an unsigned integer as little-endian bytes.
+ * Parameters:
+ *** unsigned char *buffer: Destination buffer.
+ *** unsigned long long value: The value to write.
+ *** int bytes: Number of bytes to write.
+ */
+static void putLittleEndian(unsigned char *buffer, unsigned long long value, int bytes) {
+    for (int i = 0; i < bytes; i++) {
+        buffer[i] = (unsigned char)(value >> (8 * i));
+    }
+}
+
+/**
+ * Function name: getLittleEndian
+ * Description: Read an unsigned integer stored as little-endian bytes.
+ * Parameters:
+ *** const unsigned char *buffer: Source buffer.
+ *** int bytes: Number of bytes to read.
+ * Return value:
+ *** unsigned long long: The value.
+ */
+static unsigned long long getLittleEndian(const unsigned char *buffer, int bytes) {
+    unsigned long long value = 0;
+    for (int i = 0; i < bytes; i++) {
+        value |= (unsigned long long)buffer[i] << (8 * i);
+    }
+    return value;
+}
+
+/**
+ * Function name: encodeColumn
+ * Description: Encode one column of the buffered rows.
+ * Parameters:
+ *** Exporter *exporter: Pointer to the exporter.
+ *** int column: Index into the column table.
+ *** unsigned char *out: Destination buffer, EXPORT_CHUNK_ROWS * MAX_VARINT_BYTES bytes.
+ * Return value:
+ *** int: The number of bytes written.
+ */
+static int encodeColumn(Exporter *exporter, int column, unsigned char *out) {
+    int length = 0;
+    long long previous = 0;
+
+    switch (columns[column].encoding) {
+        case ENCODING_DELTA_VARINT:
+            for (int i = 0; i < exporter->rowCount; i++) {
+                long long value = columnValue(&exporter->rows[i], columns[column].id);
+                length += putVarint(out + length, zigzagEncode(value - previous));
+                previous = value;
+            }
+            break;
+        case ENCODING_VARINT:
+            for (int i = 0; i < exporter->rowCount; i++) {
+                length += putVarint(out + length, zigzagEncode(columnValue(&exporter->rows[i], columns[column].id)));
+            }
+            break;
+        case ENCODING_FIXED8:
+            for (int i = 0; i < exporter->rowCount; i++) {
+                long long value = columnValue(&exporter->rows[i], columns[column].id);
+                out[length++] = (unsigned char)value;
+            }
+            break;
+        case ENCODING_PACKED2:
+            length = (exporter->rowCount + 3) / 4;
+            memset(out, 0, length);
+            for (int i = 0; i < exporter->rowCount; i++) {
+                out[i / 4] |= (unsigned char)((columnValue(&exporter->rows[i], columns[column].id) & 0x3) << (2 * (i % 4)));
+            }
+            break;
+    }
+    return length;
+}
+
+/**
+ * Function name: writeChunk
+ * Description: Encode the buffered rows column by column and append them to the binary file.
+ * Parameters:
+ *** Exporter *exporter: Pointer to the exporter.
+ */
+static void writeChunk(Exporter *exporter) {
+    static unsigned char data[EXPORT_CHUNK_ROWS * MAX_VARINT_BYTES];
+    unsigned char header[6];
+
+    if (exporter->binary == NULL || exporter->rowCount == 0) {
+        exporter->rowCount = 0;
+        return;
+    }
+
+    putLittleEndian(header, (unsigned long long)exporter->rowCount, 4);
+    fwrite(header, 1, 4, exporter->binary);
+    for (int c = 0; c < EXPORT_NUM_COLUMNS; c++) {
+        int length = encodeColumn(exporter, c, data);
+        header[0] = (unsigned char)columns[c].id;
+        header[1] = (unsigned char)columns[c].encoding;
+        putLittleEndian(header + 2, (unsigned long long)length, 4);
+        fwrite(header, 1, 6, exporter->binary);
+        fwrite(data, 1, length, exporter->binary);
+    }
+    exporter->rowCount = 0;
+}
+
+/**
+ * Function name: flushCsv
+ * Description: Write the buffered CSV text to the CSV file.
+ * Parameters:
+ *** Exporter *exporter: Pointer to the exporter.
+ */
+static void flushCsv(Exporter *exporter) {
+    if (exporter->csvLength > 0) {
+        fwrite(exporter->csvBuffer, 1, exporter->csvLength, exporter->csv);
+        exporter->csvLength = 0;
+    }
+}
+
+/**
+ * Function name: appendCsvInt
+ * Description: Append a decimal integer followed by a separator to the CSV buffer, without printf.
+ * Parameters:
+ *** Exporter *exporter: Pointer to the exporter.
+ *** long long value: The value to append.
+ *** char separator: Character written after the value.
+ */
+static void appendCsvInt(Exporter *exporter, long long value, char separator) {
+    char digits[24];
+    int count = 0;
+    char *out = exporter->csvBuffer + exporter->csvLength;
+    unsigned long long magnitude = value < 0 ? 0ULL - (unsigned long long)value : (unsigned long long)value;
+
+    do {
+        digits[count++] = (char)('0' + magnitude % 10);
+        magnitude /= 10;
+    } while (magnitude > 0);
+    if (value < 0) {
+        *out++ = '-';
+    }
+    while (count > 0) {
+        *out++ = digits[--count];
+    }
+    *out++ = separator;
+    exporter->csvLength = (int)(out - exporter->csvBuffer);
+}
+
+/**
+ * Function name: openExporter
+ * Description: Open the export files and write their headers. Either path may be NULL.
+ * Parameters:
+ *** Exporter *exporter: Pointer to the exporter to be initialized.
+ *** const char *binaryPath: Path of the columnar binary file, or NULL.
+ *** const char *csvPath: Path of the CSV file, or NULL.
+ * Return value:
+ *** int: Returns 1 on success, otherwise returns 0.
+ */
+int openExporter(Exporter *exporter, const char *binaryPath, const char *csvPath) {
+    memset(exporter, 0, sizeof(*exporter));
+
+    if (binaryPath != NULL) {
+        exporter->binary = fopen(binaryPath, "wb");
+        if (exporter->binary == NULL) {
+            printf("|-[ ! ]- [ Cannot open export file %s\n", binaryPath);
+            return 0;
+        }
+        unsigned char header[6];
+        memcpy(header, EXPORT_MAGIC, 4);
+        header[4] = EXPORT_VERSION;
+        header[5] = EXPORT_NUM_COLUMNS;
+        fwrite(header, 1, sizeof(header), exporter->binary);
+        for (int c = 0; c < EXPORT_NUM_COLUMNS; c++) {
+            unsigned char descriptor[3] = { (unsigned char)columns[c].id, (unsigned char)columns[c].encoding,
+                                            (unsigned char)strlen(columns[c].name) };
+            fwrite(descriptor, 1, sizeof(descriptor), exporter->binary);
+            fwrite(columns[c].name, 1, descriptor[2], exporter->binary);
+        }
+    }
+
+    if (csvPath != NULL) {
+        exporter->csv = fopen(csvPath, "w");
+        if (exporter->csv == NULL) {
+            printf("|-[ ! ]- [ Cannot open export file %s\n", csvPath);
+            if (exporter->binary != NULL) {
+                fclose(exporter->binary);
+            }
+            return 0;
+        }
+        for (int c = 0; c < EXPORT_NUM_COLUMNS; c++) {
+            fputs(columns[c].name, exporter->csv);
+            fputc(c + 1 < EXPORT_NUM_COLUMNS ? ',' : '\n', exporter->csv);
+        }
+    }
+    return 1;
+}
+
+/**
+ * Function name: exportCompletion
+ * Description: Add a completed transaction to the export.
+ * Parameters:
+ *** Exporter *exporter: Pointer to the exporter.
+ *** const CompletionRecord *record: Pointer to the completion record.
+ */
+void exportCompletion(Exporter *exporter, const CompletionRecord *record) {
+    exporter->totalRows++;
+
+    if (exporter->binary != NULL) {
+        exporter->rows[exporter->rowCount++] = *record;
+        if (exporter->rowCount == EXPORT_CHUNK_ROWS) {
+            writeChunk(exporter);
+        }
+    }
+
+    if (exporter->csv != NULL) {
+        if (exporter->csvLength > EXPORT_CSV_BUFFER - CSV_MAX_ROW) {
+            flushCsv(exporter);
+        }
+        for (int c = 0; c < EXPORT_NUM_COLUMNS; c++) {
+            appendCsvInt(exporter, columnValue(record, columns[c].id), c + 1 < EXPORT_NUM_COLUMNS ? ',' : '\n');
+        }
+    }
+}
+
+/**
+ * Function name: closeExporter
+ * Description: Write the last chunk and the trailer, then close the export files.
+ * Parameters:
+ *** Exporter *exporter: Pointer to the exporter.
+ * Return value:
+ *** int: Returns 1 if everything was written, otherwise returns 0.
+ */
+int closeExporter(Exporter *exporter) {
+    int ok = 1;
+
+    if (exporter->binary != NULL) {
+        unsigned char trailer[12];
+        writeChunk(exporter);
+        putLittleEndian(trailer, 0, 4);
+        putLittleEndian(trailer + 4, (unsigned long long)exporter->totalRows, 8);
+        fwrite(trailer, 1, sizeof(trailer), exporter->binary);
+        ok = !ferror(exporter->binary) && ok;
+        ok = fclose(exporter->binary) == 0 && ok;
+        exporter->binary = NULL;
+    }
+
+    if (exporter->csv != NULL) {
+        flushCsv(exporter);
+        ok = !ferror(exporter->csv) && ok;
+        ok = fclose(exporter->csv) == 0 && ok;
+        exporter->csv = NULL;
+    }
+
+    if (!ok) {
+        printf("|-[ ! ]- [ Export did not complete, output files may be truncated\n");
+    }
+    return ok;
+}
+
+/**
+ * Function name: openExportReader
+ * Description: Open a columnar export file and check that its header describes the columns written by openExporter.
+ * Parameters:
+ *** ExportReader *reader: Pointer to the reader to be initialized.
+ *** const char *path: Path of the columnar binary file.
+ * Return value:
+ *** int: Returns 1 on success, otherwise returns 0.
+ */
+int openExportReader(ExportReader *reader, const char *path) {
+    unsigned char header[6];
+    memset(reader, 0, sizeof(*reader));
+
+    reader->file = fopen(path, "rb");
+    if (reader->file == NULL) {
+        printf("|-[ ! ]- [ Cannot open export file %s\n", path);
+        return 0;
+    }
+    int ok = fread(header, 1, sizeof(header), reader->file) == sizeof(header) &&
+             memcmp(header, EXPORT_MAGIC, 4) == 0 && header[4] == EXPORT_VERSION && header[5] == EXPORT_NUM_COLUMNS;
+    for (int c = 0; c < EXPORT_NUM_COLUMNS && ok; c++) {
+        unsigned char descriptor[3];
+        char name[256];
+        ok = fread(descriptor, 1, sizeof(descriptor), reader->file) == sizeof(descriptor) &&
+             descriptor[0] == columns[c].id && descriptor[1] == columns[c].encoding &&
+             fread(name, 1, descriptor[2], reader->file) == descriptor[2] &&
+             descriptor[2] == strlen(columns[c].name) && memcmp(name, columns[c].name, descriptor[2]) == 0;
+    }
+    if (!ok) {
+        printf("|-[ ! ]- [ %s is not an export file of this version\n", path);
+        closeExportReader(reader);
+        return 0;
+    }
+    return 1;
+}
+
+/**
+ * Function name: decodeColumn
+ * Description: Decode one column of a chunk into the rows.
+ * Parameters:
+ *** ExportReader *reader: Pointer to the reader, its data holds the encoded column.
+ *** int column: Index into the column table.
+ *** int length: Number of encoded bytes.
+ *** CompletionRecord *rows: The rows of the chunk.
+ *** int rowCount: Number of rows in the chunk.
+ * Return value:
+ *** int: Returns 1 if the column decoded exactly, otherwise returns 0.
+ */
+static int decodeColumn(ExportReader *reader, int column, int length, CompletionRecord *rows, int rowCount) {
+    const unsigned char *data = reader->data;
+    long long previous = 0;
+    int position = 0;
+
+    for (int i = 0; i < rowCount; i++) {
+        long long value;
+        unsigned long long raw;
+        int used;
+        switch (columns[column].encoding) {
+            case ENCODING_DELTA_VARINT:
+            case ENCODING_VARINT:
+                used = getVarint(data + position, length - position, &raw);
+                if (used == 0) {
+                    return 0;
+                }
+                position += used;
+                value = zigzagDecode(raw);
+                if (columns[column].encoding == ENCODING_DELTA_VARINT) {
+                    value += previous;
+                    previous = value;
+                }
+                break;
+            case ENCODING_FIXED8:
+                if (position == length) {
+                    return 0;
+                }
+                value = data[position++];
+                break;
+            default: // ENCODING_PACKED2
+                position = (i + 4) / 4;
+                if (position > length) {
+                    return 0;
+                }
+                value = (data[i / 4] >> (2 * (i % 4))) & 0x3;
+                break;
+        }
+
+        CompletionRecord *record = &rows[i];
+        switch (columns[column].id) {
+            case COLUMN_STUB:
+                record->transaction.stubNumber = (int)value;
+                break;
+            case COLUMN_AMOUNT:
+                record->transaction.amount = (int)value;
+                break;
+            case COLUMN_ACCOUNT_TYPE:
+                record->transaction.accountType = (int)value;
+                break;
+            case COLUMN_DURATION:
+                record->transaction.duration = (int)value;
+                break;
+            case COLUMN_TELLER:
+                record->teller = (int)value;
+                break;
+            case COLUMN_ARRIVAL_TIME:
+                record->transaction.arrivalTime = (int)value;
+                break;
+            case COLUMN_START_TIME:
+                reader->startTimes[i] = (int)value; // Checked against completed_at and duration by the caller
+                break;
+            case COLUMN_COMPLETED_AT:
+                record->completedAt = (int)value;
+                break;
+        }
+    }
+    return position == length;
+}
+
+/**
+ * Function name: readExportChunk
+ * Description: Decode the next chunk of a columnar export file.
+ * Parameters:
+ *** ExportReader *reader: Pointer to the reader.
+ *** CompletionRecord *rows: Array with room for EXPORT_CHUNK_ROWS rows.
+ * Return value:
+ *** int: The number of rows decoded, 0 once the trailer was read and matches the rows decoded,
+ ***      or -1 if the file is truncated or damaged.
+ */
+int readExportChunk(ExportReader *reader, CompletionRecord *rows) {
+    unsigned char header[8];
+    int chunk = reader->chunkCount;
+
+    if (fread(header, 1, 4, reader->file) != 4) {
+        printf("|-[ ! ]- [ Export file ends without a trailer after chunk %d\n", chunk);
+        return -1;
+    }
+    int rowCount = (int)getLittleEndian(header, 4);
+    if (rowCount == 0) {
+        if (fread(header, 1, 8, reader->file) != 8 || (long long)getLittleEndian(header, 8) != reader->rowsRead) {
+            printf("|-[ ! ]- [ Export trailer does not match the %lld rows read\n", reader->rowsRead);
+            return -1;
+        }
+        return 0;
+    }
+    if (rowCount < 0 || rowCount > EXPORT_CHUNK_ROWS) {
+        printf("|-[ ! ]- [ Export chunk %d is damaged\n", chunk);
+        return -1;
+    }
+
+    memset(rows, 0, rowCount * sizeof(CompletionRecord));
+    for (int c = 0; c < EXPORT_NUM_COLUMNS; c++) {
+        if (fread(header, 1, 6, reader->file) != 6 || header[0] != columns[c].id || header[1] != columns[c].encoding) {
+            printf("|-[ ! ]- [ Export chunk %d is damaged\n", chunk);
+            return -1;
+        }
+        long long length = (long long)getLittleEndian(header + 2, 4);
+        if (length > (long long)sizeof(reader->data) || fread(reader->data, 1, length, reader->file) != (size_t)length ||
+            !decodeColumn(reader, c, (int)length, rows, rowCount)) {
+            printf("|-[ ! ]- [ Export chunk %d is damaged\n", chunk);
+            return -1;
+        }
+    }
+
+    // start_time is derived, so it must agree with the columns it was derived from
+    for (int i = 0; i < rowCount; i++) {
+        rows[i].transaction.timerHandle = -1;
+        if (reader->startTimes[i] != columnValue(&rows[i], COLUMN_START_TIME)) {
+            printf("|-[ ! ]- [ Export chunk %d is damaged\n", chunk);
+            return -1;
+        }
+    }
+    reader->chunkCount++;
+    reader->rowsRead += rowCount;
+    return rowCount;
+}
+
+/**
+ * Function name: closeExportReader
+ * Description: Close the export file.
+ * Parameters:
+ *** ExportReader *reader: Pointer to the reader.
+ */
+void closeExportReader(ExportReader *reader) {
+    if (reader->file != NULL) {
+        fclose(reader->file);
+        reader->file = NULL;
+    }
+}
@@ -0,0 +1,69 @@
+#ifndef EXPORT_H
+#define EXPORT_H
+
+#include <stdio.h>
+#include "encoding.h"
+#include "streamstats.h"
+
+// Define the chunk size and the CSV write buffer size
+#define EXPORT_CHUNK_ROWS 4096
+#define EXPORT_CSV_BUFFER 65536
+#define EXPORT_NUM_COLUMNS 8
+
+// Define the column ids
+#define COLUMN_STUB 0
+#define COLUMN_AMOUNT 1
+#define COLUMN_ACCOUNT_TYPE 2
+#define COLUMN_DURATION 3
+#define COLUMN_TELLER 4
+#define COLUMN_ARRIVAL_TIME 5
+#define COLUMN_START_TIME 6
+#define COLUMN_COMPLETED_AT 7
+
+// Define the column encodings
+#define ENCODING_DELTA_VARINT 1 // Zigzag varint of the difference to the previous row of the chunk
+#define ENCODING_VARINT 2       // Zigzag varint of the value
+#define ENCODING_FIXED8 3       // One unsigned byte per row, only for columns that always fit
+#define ENCODING_PACKED2 4      // Two bits per row, four rows per byte, first row in the low bits
+
+/*
+ * Binary layout, all multi-byte integers little-endian:
+ *
+ *   header:  "CCDX", u8 version, u8 column count,
+ *            column count x (u8 column id, u8 encoding, u8 name length, name)
+ *   chunk:   u32 row count (at most EXPORT_CHUNK_ROWS),
+ *            column count x (u8 column id, u8 encoding, u32 byte length, encoded data)
+ *   trailer: u32 0, u64 total rows
+ *
+ * Delta encoded columns restart from 0 at every chunk, so chunks can be decoded independently.
+ */
+
+// Define a streaming exporter of completed transactions
+typedef struct {
+    FILE *binary;                           // Columnar output, or NULL
+    FILE *csv;                              // CSV output, or NULL
+    CompletionRecord rows[EXPORT_CHUNK_ROWS];
+    int rowCount;                           // Rows buffered for the next chunk
+    long long totalRows;
+    char csvBuffer[EXPORT_CSV_BUFFER];
+    int csvLength;
+} Exporter;
+
+// Define a reader of the columnar file that decodes one chunk at a time
+typedef struct {
+    FILE *file;
+    int chunkCount;                         // Chunks decoded so far
+    long long rowsRead;
+    unsigned char data[EXPORT_CHUNK_ROWS * MAX_VARINT_BYTES];
+    int startTimes[EXPORT_CHUNK_ROWS];      // Decoded start_time column, checked against the other columns
+} ExportReader;
+
+// Function declarations
+int openExporter(Exporter *exporter, const char *binaryPath, const char *csvPath);
+void exportCompletion(Exporter *exporter, const CompletionRecord *record);
+int closeExporter(Exporter *exporter);
+int openExportReader(ExportReader *reader, const char *path);
+int readExportChunk(ExportReader *reader, CompletionRecord *rows);
+void closeExportReader(ExportReader *reader);
+
+#endif // EXPORT_H
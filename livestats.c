@@ -0,0 +1,179 @@
+#include "livestats.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/**
+ * Function name: unlinkOwnRegion
+ * Description: Remove the shared memory name, but only while it still refers to the object this process created.
+ * Parameters:
+ *** const LiveStats *live: Pointer to the live statistics.
+ */
+static void unlinkOwnRegion(const LiveStats *live) {
+    struct stat status;
+    int fd = shm_open(live->name, O_RDONLY, 0);
+    if (fd < 0) {
+        return; // Already removed by someone else
+    }
+    int own = fstat(fd, &status) == 0 && status.st_dev == live->device && status.st_ino == live->inode;
+    close(fd);
+    if (own) {
+        shm_unlink(live->name);
+    }
+}
+
+/**
+ * Function name: openLiveStats
+ * Description: Create the shared memory region the simulator publishes its state into. The name must not
+ *              exist yet, so two simulations never publish into, or remove, the same region.
+ * Parameters:
+ *** LiveStats *live: Pointer to the live statistics to be initialized.
+ *** const char *name: Name of the shared memory object, for example /ccdsalg.
+ * Return value:
+ *** int: Returns 1 on success, otherwise returns 0.
+ */
+int openLiveStats(LiveStats *live, const char *name) {
+    memset(live, 0, sizeof(*live));
+    snprintf(live->name, sizeof(live->name), "%s%s", name[0] == '/' ? "" : "/", name);
+
+    int fd = shm_open(live->name, O_CREAT | O_EXCL | O_RDWR, 0644);
+    if (fd < 0 && errno == EEXIST) {
+        printf("|-[ ! ]- [ Shared memory %s is in use by another simulation, or was left behind by one that was killed.\n"
+               "|-[ ! ]- [ Pick another name, or remove /dev/shm%s if no simulation is running\n", live->name, live->name);
+        return 0;
+    }
+    if (fd < 0) {
+        printf("|-[ ! ]- [ Cannot create shared memory %s\n", live->name);
+        return 0;
+    }
+    struct stat status;
+    if (fstat(fd, &status) != 0 || ftruncate(fd, sizeof(LiveStatsRegion)) != 0) {
+        printf("|-[ ! ]- [ Cannot size shared memory %s\n", live->name);
+        close(fd);
+        shm_unlink(live->name); // Created above, nobody else can have it yet
+        return 0;
+    }
+    live->device = status.st_dev;
+    live->inode = status.st_ino;
+    void *memory = mmap(NULL, sizeof(LiveStatsRegion), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd); // The mapping keeps the object alive
+    if (memory == MAP_FAILED) {
+        printf("|-[ ! ]- [ Cannot map shared memory %s\n", live->name);
+        unlinkOwnRegion(live);
+        return 0;
+    }
+
+    live->region = (LiveStatsRegion *)memory;
+    memset(&live->region->snapshot, 0, sizeof(LiveSnapshot));
+    atomic_store_explicit(&live->region->sequence, 0, memory_order_relaxed);
+    live->region->version = LIVE_STATS_VERSION;
+    atomic_thread_fence(memory_order_release);
+    live->region->magic = LIVE_STATS_MAGIC; // Written last, monitors only trust a region carrying it
+    return 1;
+}
+
+/**
+ * Function name: beginLiveUpdate
+ * Description: Start writing a new snapshot. Readers retry until endLiveUpdate is called.
+ * Parameters:
+ *** LiveStats *live: Pointer to the live statistics.
+ * Return value:
+ *** LiveSnapshot *: The snapshot to fill in.
+ */
+LiveSnapshot *beginLiveUpdate(LiveStats *live) {
+    unsigned int sequence = atomic_load_explicit(&live->region->sequence, memory_order_relaxed);
+    atomic_store_explicit(&live->region->sequence, sequence + 1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+    return &live->region->snapshot;
+}
+
+/**
+ * Function name: endLiveUpdate
+ * Description: Publish the snapshot written since beginLiveUpdate.
+ * Parameters:
+ *** LiveStats *live: Pointer to the live statistics.
+ */
+void endLiveUpdate(LiveStats *live) {
+    unsigned int sequence = atomic_load_explicit(&live->region->sequence, memory_order_relaxed);
+    atomic_store_explicit(&live->region->sequence, sequence + 1, memory_order_release);
+}
+
+/**
+ * Function name: closeLiveStats
+ * Description: Mark the simulation as finished, then unmap and remove the shared memory region.
+ *              Monitors that are still attached keep their mapping and see the final snapshot.
+ * Parameters:
+ *** LiveStats *live: Pointer to the live statistics.
+ */
+void closeLiveStats(LiveStats *live) {
+    if (live->region == NULL) {
+        return;
+    }
+    beginLiveUpdate(live)->running = 0;
+    endLiveUpdate(live);
+    munmap(live->region, sizeof(LiveStatsRegion));
+    unlinkOwnRegion(live);
+    live->region = NULL;
+}
+
+/**
+ * Function name: attachLiveStats
+ * Description: Map the shared memory region of a running simulation for reading.
+ * Parameters:
+ *** const char *name: Name of the shared memory object.
+ * Return value:
+ *** LiveStatsRegion *: The mapped region, or NULL if no simulation publishes under that name.
+ */
+LiveStatsRegion *attachLiveStats(const char *name) {
+    char path[LIVE_STATS_NAME_SIZE];
+    snprintf(path, sizeof(path), "%s%s", name[0] == '/' ? "" : "/", name);
+
+    int fd = shm_open(path, O_RDONLY, 0);
+    if (fd < 0) {
+        printf("|-[ ! ]- [ No simulation publishes %s\n", path);
+        return NULL;
+    }
+    void *memory = mmap(NULL, sizeof(LiveStatsRegion), PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (memory == MAP_FAILED) {
+        printf("|-[ ! ]- [ Cannot map shared memory %s\n", path);
+        return NULL;
+    }
+
+    LiveStatsRegion *region = (LiveStatsRegion *)memory;
+    if (region->magic != LIVE_STATS_MAGIC || region->version != LIVE_STATS_VERSION) {
+        printf("|-[ ! ]- [ %s is not a live statistics region of this version\n", path);
+        munmap(memory, sizeof(LiveStatsRegion));
+        return NULL;
+    }
+    atomic_thread_fence(memory_order_acquire);
+    return region;
+}
+
+/**
+ * Function name: readLiveStats
+ * Description: Copy a consistent snapshot out of the shared region without ever blocking the simulator.
+ * Parameters:
+ *** LiveStatsRegion *region: The region returned by attachLiveStats.
+ *** LiveSnapshot *snapshot: Pointer to store the snapshot.
+ * Return value:
+ *** int: Returns 1 on success, or 0 if the simulator kept updating for LIVE_STATS_MAX_RETRIES attempts.
+ */
+int readLiveStats(LiveStatsRegion *region, LiveSnapshot *snapshot) {
+    for (int attempt = 0; attempt < LIVE_STATS_MAX_RETRIES; attempt++) {
+        unsigned int before = atomic_load_explicit(&region->sequence, memory_order_acquire);
+        if (before & 1) {
+            continue; // An update is in progress
+        }
+        memcpy(snapshot, &region->snapshot, sizeof(*snapshot));
+        atomic_thread_fence(memory_order_acquire);
+        if (atomic_load_explicit(&region->sequence, memory_order_relaxed) == before) {
+            return 1;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,61 @@
+#ifndef LIVESTATS_H
+#define LIVESTATS_H
+
+#include <stdatomic.h>
+#include <sys/types.h>
+#include "queue.h"
+
+// Define the identity of the shared region and the number of tellers it describes
+#define LIVE_STATS_MAGIC 0x5453434C // "LCST"
+#define LIVE_STATS_VERSION 1
+#define LIVE_STATS_TELLERS 5
+#define LIVE_STATS_NAME_SIZE 64
+#define LIVE_STATS_MAX_RETRIES 1000
+
+// Define one consistent view of the simulation
+typedef struct {
+    int time;                                // Minutes simulated so far
+    int running;                             // 0 once the simulation has exited
+    int pendingSize;
+    int extraState;                          // TELLER_CLOSED, TELLER_OPEN or TELLER_DRAINING
+    double predictedWait;                    // Predicted wait of the last scaling decision
+    int nextStub;                            // Stub number given to the next customer
+    int isBusy[LIVE_STATS_TELLERS];
+    int remainingTime[LIVE_STATS_TELLERS];
+    int currentStub[LIVE_STATS_TELLERS];     // 0 when idle
+    int queueSize[LIVE_STATS_TELLERS];
+    int completedCount[LIVE_STATS_TELLERS];
+    int busyTime[LIVE_STATS_TELLERS];
+    int balked[NUM_ACCOUNT_TYPES];
+    int reneged[NUM_ACCOUNT_TYPES];
+} LiveSnapshot;
+
+/*
+ * The shared region is guarded by a seqlock. The simulator makes the sequence odd,
+ * updates the snapshot and makes it even again. Readers copy the snapshot and retry
+ * when the sequence was odd or changed meanwhile, so the simulator never waits on them.
+ */
+typedef struct {
+    unsigned int magic;
+    unsigned int version;
+    atomic_uint sequence;
+    LiveSnapshot snapshot;
+} LiveStatsRegion;
+
+// Define the simulator side of the shared region
+typedef struct {
+    LiveStatsRegion *region;
+    char name[LIVE_STATS_NAME_SIZE];
+    dev_t device;                            // Identity of the object this process created under the name
+    ino_t inode;
+} LiveStats;
+
+// Function declarations
+int openLiveStats(LiveStats *live, const char *name);
+LiveSnapshot *beginLiveUpdate(LiveStats *live);
+void endLiveUpdate(LiveStats *live);
+void closeLiveStats(LiveStats *live);
+LiveStatsRegion *attachLiveStats(const char *name);
+int readLiveStats(LiveStatsRegion *region, LiveSnapshot *snapshot);
+
+#endif // LIVESTATS_H
@@ -1,285 +1,365 @@
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <time.h>
+#include <unistd.h>
+#include "bank.h"
+#include "dashboard.h"
+#include "livestats.h"
 #include "queue.h"
+#include "scaling.h"
+#include "server.h"
 #include "stack.h"
+#include "streamstats.h"
+#include "trace.h"
 #include "transaction.h"
-
-#define MAX_EXTRA_QUEUE_TRANSACTIONS 10
-#define NUM_TELLERS 5
-#define MAX_TRANSACTIONS 60
-
-typedef struct {
-    Transaction currentTransaction;
-    int isBusy;
-    int remainingTime;
-} TellerStatus;
+#include "whatif.h"
 
 /**
- * Function name: getRandomDuration
- * Description: Generate a random duration for the transaction based on the account type.
+ * Function name: buildDashboardFrame
+ * Description: Describe the current simulation state as dashboard lines, one per teller and one per queue.
  * Parameters:
- *** int accountType: The type of account for the transaction.
- * Return value:
- *** int: The random duration for the transaction.
+ *** Dashboard *d: Pointer to the dashboard.
+ *** Bank *bank: Pointer to the bank.
  */
-int getRandomDuration(int accountType) {
-    int min, max;
-    switch (accountType) {
-        case NEW:
-            min = 8; max = 10;
-            break;
-        case GOVERNMENT:
-            min = 10; max = 15;
-            break;
-        case CHECKING:
-            min = 5; max = 8;
-            break;
-        case SAVINGS:
-            min = 5; max = 7;
-            break;
-        default:
-            min = 0; max = 0; // Should never happen
+void buildDashboardFrame(Dashboard *d, Bank *bank) {
+    int hours, minutes, seconds;
+    convertTime(bank->totalTimeElapsed, &hours, &minutes, &seconds);
+
+    beginFrame(d);
+    frameLine(d, "|================================================[ BANK SIMULATOR ]================================================|");
+    frameLine(d, "|-[ ! ]-[ Time Elapsed: %02d:%02d:%02d", hours, minutes, seconds);
+    frameLine(d, "|==================================================================================================================|");
+    for (int i = 0; i < NUM_TELLERS; i++) {
+        if (bank->isBusy[i]) {
+            frameLine(d, "|-[ %d ]-[ Teller %d is processing transaction: Stub %d, Amount: %d, %s Account, %d Minutes Remaining...",
+                      i + 1, i + 1, bank->currentTransaction[i].stubNumber, bank->currentTransaction[i].amount,
+                      accountTypeStr[bank->currentTransaction[i].accountType], bank->remainingTime[i]);
+        } else if (i == EXTRA_TELLER && bank->extraState == TELLER_CLOSED) {
+            frameLine(d, "|-[ %d ]-[ Teller %d is closed", i + 1, i + 1);
+        } else {
+            frameLine(d, "|-[ %d ]-[ Teller %d is idle", i + 1, i + 1);
+        }
     }
-    return min + rand() % (max - min + 1);
+    frameLine(d, "|==================================================================================================================|");
+    for (int i = 0; i <= NUM_TELLERS; i++) {
+        Queue *q = i < NUM_TELLERS ? &bank->tellers[i] : &bank->pendingQueue;
+        char cells[DASHBOARD_LINE_SIZE];
+        int length = 0;
+        int index = q->front;
+        for (int count = 0; count < q->size && length < (int)sizeof(cells); count++) {
+            length += snprintf(cells + length, sizeof(cells) - length, " #%d", q->transactions[index].stubNumber);
+            index = (index + 1) % MAX_QUEUE_SIZE;
+        }
+        cells[length < (int)sizeof(cells) ? length : (int)sizeof(cells) - 1] = '\0';
+        if (i < NUM_TELLERS) {
+            frameLine(d, "|-[ Q%d ]-[ Teller %d Queue: %2d waiting ]-[%s", i + 1, i + 1, q->size, cells);
+        } else {
+            frameLine(d, "|-[ Q! ]-[ Pending Queue:  %2d waiting ]-[%s", q->size, cells);
+        }
+    }
+    frameLine(d, "|==================================================================================================================|");
+    frameLine(d, "%s", lastEvent[0] != '\0' ? lastEvent : "|-[ ! ]-[ No events yet");
 }
 
 /**
- * Function name: processTransaction
- * Description: Process a single transaction for a given teller.
- * Parameters:
- *** Queue *q: Pointer to the queue of transactions.
- *** Stack *s: Pointer to the stack of completed transactions.
- *** TellerStatus *tellerStatus: Pointer to the teller's status.
- *** int *totalTimeElapsed: Pointer to the total time elapsed.
- *** int *tellerTimes: Array to accumulate transaction times for each teller.
+ * Function name: waitForEnter
+ * Description: Skip the rest of the current input line, then wait until the user presses Enter.
  */
-void processTransaction(Queue *q, Stack *s, TellerStatus *tellerStatus, int *totalTimeElapsed, int tellerIndex, int *tellerTimes) {
-    if (!tellerStatus->isBusy && !isQueueEmpty(q)) {
-        tellerStatus->currentTransaction = dequeue(q);
-        tellerStatus->remainingTime = tellerStatus->currentTransaction.duration;
-        tellerStatus->isBusy = 1;
+void waitForEnter(void) {
+    int c;
+    while ((c = getchar()) != '\n' && c != EOF) {
     }
-
-    if (tellerStatus->isBusy) {
-        tellerStatus->remainingTime--;
-        tellerTimes[tellerIndex]++; // Accumulate the time for this teller
-        if (tellerStatus->remainingTime == 0) {
-            push(s, tellerStatus->currentTransaction);
-            printf("\n|-[ ! ]-[ Completed Transaction: Stub %d, Amount: %d, %s Account, Duration: %d minutes\n",
-                   tellerStatus->currentTransaction.stubNumber, tellerStatus->currentTransaction.amount,
-                   accountTypeStr[tellerStatus->currentTransaction.accountType],
-                   tellerStatus->currentTransaction.duration);
-            tellerStatus->isBusy = 0;
-        }
+    while (c != EOF && (c = getchar()) != '\n' && c != EOF) {
     }
 }
 
 /**
- * Function name: convertTime
- * Description: Convert total minutes into hours, minutes, and seconds format.
+ * Function name: printUsage
+ * Description: Print the command line options.
  * Parameters:
- *** int totalTimeElapsed: The total time elapsed in minutes.
- *** int *hours: Pointer to the hours component.
- *** int *minutes: Pointer to the minutes component.
- *** int *seconds: Pointer to the seconds component.
+ *** const char *program: Name of the executable.
  */
-void convertTime(int totalTimeElapsed, int *hours, int *minutes, int *seconds) {
-    *hours = totalTimeElapsed / 60;
-    *minutes = totalTimeElapsed % 60;
-    *seconds = 0; // No need to compute seconds from minutes
+void printUsage(const char *program) {
+    printf("Usage: %s [--stream <spill directory>] [--dashboard [fps]] [--server <socket path> [--tick-ms <ms>]] [--scaling adaptive|legacy] [--abandon]\n"
+           "       [--export-bin <file>] [--export-csv <file>] [--trace <binary trace>] [--live <shared memory name>]\n"
+           "       [--seed <n>] [--whatif <variant>]... [--snapshot-every <minutes>]\n", program);
 }
 
-/**
- * Function name: OpenNewQueue
- * Description: Activate the 5th queue if all regular queues (savings and checking) 
- *              are full and pending queue is at least 50% capacity.
- * Parameters:
- *** Queue *tellers: Array of teller queues.
- *** Queue *pendingQueue: Pointer to the pending queue.
- *** int pendingQueueCondition: The condition for the pending queue to trigger opening a new queue.
- */
-void OpenNewQueue(Queue *tellers, Queue *pendingQueue, int pendingQueueCondition) {
-    int allFull = 1;
-    for (int i = 2; i <= 3; i++) {
-        if (!isQueueFull(&tellers[i], CHECKING) || !isQueueFull(&tellers[i], SAVINGS)) {
-            allFull = 0;
-            break;
+int main(int argc, char *argv[]) {
+    unsigned long long seed = (unsigned long long)time(NULL);
+
+    // Streaming mode keeps rolling aggregates instead of every completed transaction
+    static StreamStats streamStats;
+    static Dashboard dashboard;
+    static Bank bank;
+    static Stack completedTransactions[NUM_TELLERS];
+    static Exporter exporter;
+    static TraceReader trace;
+    static LiveStats live;
+    int streaming = 0;
+    int useDashboard = 0;
+    int dashboardFps = DASHBOARD_DEFAULT_FPS;
+    const char *socketPath = NULL;
+    int tickMillis = SERVER_DEFAULT_TICK_MS;
+    const ScalingPolicy *scaling = findScalingPolicy(NULL);
+    int abandonment = 0;
+    const char *exportBinary = NULL;
+    const char *exportCsv = NULL;
+    int replaying = 0;
+    int traceFailed = 0;
+    const char *liveName = NULL;
+    const char *variants[WHATIF_MAX_VARIANTS];
+    int variantCount = 0;
+    int snapshotInterval = WHATIF_DEFAULT_INTERVAL;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--stream") == 0 && i + 1 < argc) {
+            if (!initStreamStats(&streamStats, argv[++i])) {
+                return 1;
+            }
+            streaming = 1;
+        } else if (strcmp(argv[i], "--dashboard") == 0) {
+            useDashboard = 1;
+            if (i + 1 < argc && argv[i + 1][0] >= '0' && argv[i + 1][0] <= '9') {
+                dashboardFps = atoi(argv[++i]);
+            }
+        } else if (strcmp(argv[i], "--server") == 0 && i + 1 < argc) {
+            socketPath = argv[++i];
+        } else if (strcmp(argv[i], "--tick-ms") == 0 && i + 1 < argc) {
+            tickMillis = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--scaling") == 0 && i + 1 < argc && findScalingPolicy(argv[i + 1]) != NULL) {
+            scaling = findScalingPolicy(argv[++i]);
+        } else if (strcmp(argv[i], "--abandon") == 0) {
+            abandonment = 1;
+        } else if (strcmp(argv[i], "--export-bin") == 0 && i + 1 < argc) {
+            exportBinary = argv[++i];
+        } else if (strcmp(argv[i], "--export-csv") == 0 && i + 1 < argc) {
+            exportCsv = argv[++i];
+        } else if (strcmp(argv[i], "--trace") == 0 && i + 1 < argc) {
+            if (!openTraceReader(&trace, argv[++i])) {
+                return 1;
+            }
+            replaying = 1;
+        } else if (strcmp(argv[i], "--live") == 0 && i + 1 < argc) {
+            liveName = argv[++i];
+        } else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            seed = strtoull(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "--whatif") == 0 && i + 1 < argc && variantCount < WHATIF_MAX_VARIANTS) {
+            variants[variantCount++] = argv[++i];
+        } else if (strcmp(argv[i], "--snapshot-every") == 0 && i + 1 < argc) {
+            snapshotInterval = atoi(argv[++i]);
+        } else {
+            printUsage(argv[0]);
+            return 1;
         }
     }
-
-    if (allFull && pendingQueue->size >= (pendingQueueCondition / 2)) {
-        printf("Opening 5th queue due to high pending queue and full regular queues.\n");
-        initQueue(&tellers[4]);
+    // Checked before any output is opened, so nothing is left half written or published
+    if (variantCount > 0 && !replaying) {
+        printf("|-[ ! ]- [ --whatif needs a trace to replay, use --trace\n");
+        return 1;
     }
-}
-
-/**
- * Function name: ConsolidateTransactions
- * Description: Consolidate transactions from all stacks into a single stack and display them.
- * Parameters:
- *** Stack *completedTransactions: Array of completed transaction stacks for each teller.
- *** int numTellers: The number of tellers.
- *** int *tellerTimes: Array to store accumulated transaction times for each teller.
- *** int *totalTransactions: Array to store total transactions for each teller.
- */
-void ConsolidateTransactions(Stack *completedTransactions, int numTellers, int *tellerTimes, int *totalTransactions) {
-    Stack consolidatedStack;
-    initStack(&consolidatedStack);
 
-    // Temporary array to store transactions
-    Transaction *transactions = (Transaction *)malloc(MAX_TRANSACTIONS * sizeof(Transaction));
-    int count = 0;
-
-    for (int i = 0; i < numTellers; i++) {
-        while (!isStackEmpty(&completedTransactions[i])) {
-            Transaction transaction = pop(&completedTransactions[i]);
-            transactions[count++] = transaction;
-            totalTransactions[i]++; // Increment the transaction count for each teller
-        }
+    initBank(&bank);
+    for (int i = 0; i < NUM_TELLERS; i++) {
+        initStack(&completedTransactions[i]);
     }
-
-    // Sort transactions by stub number
-    for (int i = 0; i < count - 1; i++) {
-        for (int j = i + 1; j < count; j++) {
-            if (transactions[i].stubNumber < transactions[j].stubNumber) {
-                Transaction temp = transactions[i];
-                transactions[i] = transactions[j];
-                transactions[j] = temp;
-            }
+    bank.completedTransactions = completedTransactions;
+    seedBank(&bank, seed);
+    bank.params.scaling = *scaling;
+    if (abandonment && !enableAbandonment(&bank)) {
+        return 1;
+    }
+    if (exportBinary != NULL || exportCsv != NULL) {
+        if (!openExporter(&exporter, exportBinary, exportCsv)) {
+            return 1;
         }
+        bank.exporter = &exporter;
     }
-
-    // Push sorted transactions back into the stack
-    for (int i = 0; i < count; i++) {
-        push(&consolidatedStack, transactions[i]);
+    if (streaming) {
+        bank.stream = &streamStats;
+        bank.completedTransactions = NULL;
     }
-
-    // Display sorted transactions
-    printf("\n|==========================================[ Consolidated Transactions: ]==========================================|\n");
-    while (!isStackEmpty(&consolidatedStack)) {
-        Transaction trans = pop(&consolidatedStack);
-        printf("|-[ ! ]-[ Transaction stub %d, amount %d, account type %s, duration %d minutes\n",
-               trans.stubNumber, trans.amount, accountTypeStr[trans.accountType], trans.duration);
+    if (liveName != NULL) {
+        if (!openLiveStats(&live, liveName)) {
+            return 1;
+        }
+        bank.live = &live;
+        publishLiveStats(&bank);
     }
 
-    // Display total number of transactions and average time for each teller
-    printf("\n|===========================================[ Summary of Transactions ]============================================|\n");
-    for (int i = 0; i < numTellers; i++) {
-        printf("|-[ ! ]-[ Teller %d | Total Transactions: %d, Average Time: %d minutes\n",
-               i + 1, totalTransactions[i],
-               totalTransactions[i] > 0 ? tellerTimes[i] / totalTransactions[i] : 0);
+    if (variantCount > 0) {
+        // The baseline keeps the streaming, export and live outputs, the variants only report a summary
+        quietOutput = 1;
+        int status = runWhatIf(&bank, &trace, variants, variantCount, snapshotInterval);
+        closeTraceReader(&trace);
+        if (streaming) {
+            spillPending(&streamStats);
+        }
+        if (bank.exporter != NULL && !closeExporter(&exporter)) {
+            status = 1;
+        }
+        if (bank.live != NULL) {
+            closeLiveStats(&live);
+        }
+        freeBank(&bank);
+        return status;
     }
 
-    free(transactions);
-}
-
-int main() {
-    srand(time(NULL));
-
-    Queue tellers[NUM_TELLERS];
-    Stack completedTransactions[NUM_TELLERS];
-    TellerStatus tellerStatus[NUM_TELLERS] = {0};
-    Queue pendingQueue;
-
-    int tellerTimes[NUM_TELLERS] = {0}; // Array to store accumulated transaction times
-    int totalTransactions[NUM_TELLERS] = {0}; // Array to store total transactions for each teller
-
-    // Initialize all queues and stacks
-    for (int i = 0; i < NUM_TELLERS; i++) {
-        initQueue(&tellers[i]);
-        initStack(&completedTransactions[i]);
+    if (socketPath != NULL) {
+        // The server runs unattended, so completed transactions are only counted, never stacked
+        quietOutput = 1;
+        bank.completedTransactions = NULL;
+        int status = runServer(&bank, socketPath, tickMillis);
+        if (streaming) {
+            printStreamSummary(&streamStats, bank.totalTimeElapsed);
+            spillPending(&streamStats);
+        }
+        if (bank.exporter != NULL && !closeExporter(&exporter)) {
+            status = 1;
+        }
+        if (bank.live != NULL) {
+            closeLiveStats(&live);
+        }
+        return status;
     }
-    initQueue(&pendingQueue);
 
-    int totalTimeElapsed = 0;
-    int stubNumber = 1; // Initialize the stub number
+    // Prompts are only worth drawing when someone is typing the input
+    int interactive = !replaying && isatty(STDIN_FILENO);
+    if (useDashboard) {
+        initDashboard(&dashboard, stdout, dashboardFps);
+        quietOutput = 1;
+        buildDashboardFrame(&dashboard, &bank);
+    }
 
     // Main loop
     while (1) {
         int choice;
+        TraceEvent event;
         int hours, minutes, seconds;
-        convertTime(totalTimeElapsed, &hours, &minutes, &seconds);
-        printf("|================================================[ BANK SIMULATOR ]================================================|");
-        printf("\n|-[ 1 ]-[ Add Customer to Queue");
-        printf("\n|-[ 2 ]-[ Consolidate and Display Transactions");
-        printf("\n|-[ 3 ]-[ Exit");
-        printf("\n|-[ ! ]-[ Time Elapsed: %02d:%02d:%02d", hours, minutes, seconds);
-        printf("\n|-[ ? ]-[ Enter your choice (1/2/3): ");
-        scanf("%d", &choice);
+        convertTime(bank.totalTimeElapsed, &hours, &minutes, &seconds);
+        if (!useDashboard) {
+            printf("|================================================[ BANK SIMULATOR ]================================================|");
+            printf("\n|-[ 1 ]-[ Add Customer to Queue");
+            printf("\n|-[ 2 ]-[ Consolidate and Display Transactions");
+            printf("\n|-[ 3 ]-[ Exit");
+            printf("\n|-[ ! ]-[ Time Elapsed: %02d:%02d:%02d", hours, minutes, seconds);
+            printf("\n|-[ ? ]-[ Enter your choice (1/2/3): ");
+        } else if (interactive) {
+            renderDashboard(&dashboard, 1);
+            dashboardPrompt(&dashboard, "|-[ ? ]-[ 1 = Add Customer | 2 = Consolidate | 3 = Exit | Enter your choice: ");
+        }
+        if (replaying) {
+            // A trace supplies the choice of every minute, idle minutes replay as an invalid choice
+            if (!nextTraceEvent(&trace, &event)) {
+                traceFailed = 1; // Keep what was simulated so far, but do not pass it off as the full trace
+            }
+            choice = event.type;
+        } else {
+            scanf("%d", &choice);
+        }
         // printf("  |==================================================================================================================|");
 
         switch (choice) {
             case 1: {
-                Transaction transaction;
-                transaction.stubNumber = stubNumber++; // Automatically assign a stub number
-                printf("\n|==========================================[ Enter Transaction Details: ]==========================================|");
-                printf("\n|-[ ? ]-[ Amount: ");
-                scanf("%d", &transaction.amount);
-                printf("|-[ ! ]-[ New = 0 | Government = 1 | Checking = 2 | Savings = 3");
-                printf("\n|-[ ? ]-[ Account Type (0/1/2/3): ");
-                scanf("%d", &transaction.accountType);
-                transaction.duration = getRandomDuration(transaction.accountType);
-
-                int tellerIndex = -1;
-                if (transaction.accountType == NEW || transaction.accountType == GOVERNMENT) {
-                    tellerIndex = transaction.accountType; // New and Government accounts have dedicated queues
-                } else if (transaction.accountType == CHECKING || transaction.accountType == SAVINGS) {
-                    // Distribute evenly among the available tellers
-                    tellerIndex = 2 + (transaction.accountType == CHECKING ? 0 : 1);
+                int amount, accountType;
+                if (!useDashboard) {
+                    printf("\n|==========================================[ Enter Transaction Details: ]==========================================|");
+                    printf("\n|-[ ? ]-[ Amount: ");
+                } else if (interactive) {
+                    dashboardPrompt(&dashboard, "|-[ ? ]-[ Amount: ");
+                }
+                if (replaying) {
+                    amount = event.amount;
                 } else {
-                    printf("|-[ ! ]- [ Invalid account type. Transaction ignored.\n");
+                    scanf("%d", &amount);
                 }
-
-                if (tellerIndex != -1) { // Proceed only if a valid account type was provided
-                    // Check if teller queue is full
-                    if (isQueueFull(&tellers[tellerIndex], transaction.accountType)) {
-                        // Check if pending queue is full
-                        if (isQueueFull(&pendingQueue, NEW) && isQueueFull(&pendingQueue, GOVERNMENT) &&
-                            isQueueFull(&pendingQueue, CHECKING) && isQueueFull(&pendingQueue, SAVINGS)) {
-                            OpenNewQueue(tellers, &pendingQueue, MAX_EXTRA_QUEUE_TRANSACTIONS);
-                            if (tellers[4].size < MAX_EXTRA_QUEUE_TRANSACTIONS) {
-                                enqueue(&tellers[4], transaction);
-                            } else {
-                                printf("|-[ ! ]- [ Extra queue is full. Cannot enqueue transaction.\n");
-                            }
-                        } else {
-                            enqueue(&pendingQueue, transaction);
-                            printf("|-[ ! ]- [ Transaction enqueued to pending queue.\n");
-                        }
-                    } else {
-                        enqueue(&tellers[tellerIndex], transaction);
-                    }
+                if (!useDashboard) {
+                    printf("|-[ ! ]-[ New = 0 | Government = 1 | Checking = 2 | Savings = 3");
+                    printf("\n|-[ ? ]-[ Account Type (0/1/2/3): ");
+                } else if (interactive) {
+                    dashboardPrompt(&dashboard, "|-[ ? ]-[ New = 0 | Government = 1 | Checking = 2 | Savings = 3 | Account Type: ");
                 }
+                if (replaying) {
+                    accountType = event.accountType;
+                } else {
+                    scanf("%d", &accountType);
+                }
+                addCustomer(&bank, amount, accountType);
                 break;
             }
 
             case 2:
-                // Consolidate and display all completed transactions without processing pending and queued transactions
-                ConsolidateTransactions(completedTransactions, NUM_TELLERS, tellerTimes, totalTransactions);
+                if (useDashboard) {
+                    leaveDashboard(&dashboard);
+                }
+                if (streaming) {
+                    printStreamSummary(&streamStats, bank.totalTimeElapsed);
+                } else {
+                    // Consolidate and display all completed transactions without processing pending and queued transactions
+                    ConsolidateTransactions(bank.completedTransactions, NUM_TELLERS, bank.tellerTimes, bank.totalTransactions);
+                }
+                if (bank.abandonment) {
+                    printAbandonment(&bank);
+                }
+                if (useDashboard) {
+                    if (interactive) {
+                        printf("|-[ ? ]-[ Press Enter to return to the dashboard");
+                        fflush(stdout);
+                        waitForEnter();
+                    }
+                    // The next frame pushes the report into the scrollback instead of erasing it
+                    scrollDashboard(&dashboard);
+                }
                 break;
 
             case 3:
+                if (replaying) {
+                    closeTraceReader(&trace);
+                }
+                if (streaming) {
+                    spillPending(&streamStats);
+                }
+                if (bank.live != NULL) {
+                    closeLiveStats(&live);
+                }
+                if (useDashboard) {
+                    buildDashboardFrame(&dashboard, &bank);
+                    renderDashboard(&dashboard, 1);
+                    leaveDashboard(&dashboard);
+                }
+                // Closed below the dashboard, so a failure message is not drawn over
+                int exported = bank.exporter == NULL || closeExporter(&exporter);
+                if (traceFailed) {
+                    printf("|-[ ! ]- [ Replay stopped at minute %d, the rest of the trace is unreadable\n", event.minute);
+                    return 1;
+                }
                 printf("|-[ ! ]-[ Exiting...\n");
-                return 0;
+                return exported ? 0 : 1;
 
             default:
                 // Handle invalid menu choice
-                printf("|-[ ! ]-[ Invalid choice. Try again.\n");
+                logEvent("|-[ ! ]-[ Invalid choice. Try again.\n");
         }
 
         // Process transactions for each teller
-        for (int i = 0; i < NUM_TELLERS; i++) {
-            processTransaction(&tellers[i], &completedTransactions[i], &tellerStatus[i], &totalTimeElapsed, i, tellerTimes);
+        tickBank(&bank);
+
+        if (useDashboard) {
+            // Redraw at most at the dashboard refresh rate, however fast the simulation runs
+            buildDashboardFrame(&dashboard, &bank);
+            renderDashboard(&dashboard, 0);
+            continue;
         }
 
         // Print current transactions for each teller
         printf("\n|==================================================================================================================|\n");
         for (int i = 0; i < NUM_TELLERS; i++) {
-            if (tellerStatus[i].isBusy) {
+            if (bank.isBusy[i]) {
                 printf("|-[ %d ]-[ Teller %d is processing transaction: Stub %d, Amount: %d, %s Account, %d Minutes Remaining...\n",
-                       i + 1, i + 1, tellerStatus[i].currentTransaction.stubNumber, tellerStatus[i].currentTransaction.amount,
-                       accountTypeStr[tellerStatus[i].currentTransaction.accountType], tellerStatus[i].remainingTime);
+                       i + 1, i + 1, bank.currentTransaction[i].stubNumber, bank.currentTransaction[i].amount,
+                       accountTypeStr[bank.currentTransaction[i].accountType], bank.remainingTime[i]);
+            } else if (i == EXTRA_TELLER && bank.extraState == TELLER_CLOSED) {
+                printf("|-[ %d ]-[ Teller %d is closed\n", i + 1, i + 1);
             } else {
                 printf("|-[ %d ]-[ Teller %d is idle\n", i + 1, i + 1);
             }
@@ -290,11 +370,10 @@ int main() {
         for (int i = 0; i < NUM_TELLERS; i++) {
             char queueName[20];
             snprintf(queueName, sizeof(queueName), "Teller %d", i + 1);
-            printQueueContents(&tellers[i], queueName);
+            printQueueContents(&bank.tellers[i], queueName);
             printf("|\n");
         }
-        printQueueContents(&pendingQueue, "Pending");
-        totalTimeElapsed += 1;
+        printQueueContents(&bank.pendingQueue, "Pending");
     }
 
     return 0;
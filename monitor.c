@@ -0,0 +1,68 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "livestats.h"
+
+#define MONITOR_DEFAULT_INTERVAL_MS 1000
+
+static const char *extraStateStr[] = { "closed", "open", "draining" };
+static const char *typeStr[NUM_ACCOUNT_TYPES] = { "New", "Government", "Checking", "Savings" };
+
+/**
+ * Function name: printSnapshot
+ * Description: Print one snapshot of the simulation in the style of the simulator report.
+ * Parameters:
+ *** const LiveSnapshot *s: Pointer to the snapshot.
+ */
+void printSnapshot(const LiveSnapshot *s) {
+    int completed = 0;
+    printf("|==================================================[ LIVE MONITOR ]================================================|\n");
+    printf("|-[ ! ]-[ Time Elapsed: %02d:%02d:00 | Next Stub: %d | Pending: %d | 5th teller %s, predicted wait %.1f minutes%s\n",
+           s->time / 60, s->time % 60, s->nextStub, s->pendingSize,
+           s->extraState >= 0 && s->extraState <= 2 ? extraStateStr[s->extraState] : "?", s->predictedWait,
+           s->running ? "" : " | Finished");
+    for (int i = 0; i < LIVE_STATS_TELLERS; i++) {
+        completed += s->completedCount[i];
+        if (s->isBusy[i]) {
+            printf("|-[ %d ]-[ Teller %d serving Stub %d, %d minutes remaining | Queue: %d | Completed: %d | Busy: %d minutes\n",
+                   i + 1, i + 1, s->currentStub[i], s->remainingTime[i], s->queueSize[i], s->completedCount[i], s->busyTime[i]);
+        } else {
+            printf("|-[ %d ]-[ Teller %d idle | Queue: %d | Completed: %d | Busy: %d minutes\n",
+                   i + 1, i + 1, s->queueSize[i], s->completedCount[i], s->busyTime[i]);
+        }
+    }
+    printf("|-[ ! ]-[ Completed: %d", completed);
+    for (int t = 0; t < NUM_ACCOUNT_TYPES; t++) {
+        printf(" | %s balked %d, reneged %d", typeStr[t], s->balked[t], s->reneged[t]);
+    }
+    printf("\n");
+    fflush(stdout);
+}
+
+int main(int argc, char *argv[]) {
+    if (argc < 2 || argc > 3) {
+        printf("Usage: %s <shared memory name> [interval ms, 0 prints once]\n", argv[0]);
+        return 1;
+    }
+    int intervalMillis = argc == 3 ? atoi(argv[2]) : MONITOR_DEFAULT_INTERVAL_MS;
+
+    LiveStatsRegion *region = attachLiveStats(argv[1]);
+    if (region == NULL) {
+        return 1;
+    }
+
+    // Reading never writes to the region, so the simulator is not slowed down however often we poll
+    struct timespec interval = { intervalMillis / 1000, (long)(intervalMillis % 1000) * 1000000L };
+    LiveSnapshot snapshot;
+    while (1) {
+        if (!readLiveStats(region, &snapshot)) {
+            printf("|-[ ! ]- [ Simulation is updating too fast to read, retrying\n");
+        } else {
+            printSnapshot(&snapshot);
+            if (!snapshot.running || intervalMillis <= 0) {
+                return 0;
+            }
+        }
+        nanosleep(&interval, NULL);
+    }
+}
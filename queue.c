@@ -1,5 +1,6 @@
 #include "queue.h"
 #include <stdio.h>
+#include <string.h>
 
 const char *accountTypeStr[] = { "New", "Government", "Checking", "Savings" };
 
@@ -13,7 +14,42 @@ void initQueue(Queue *q) {
     q->front = 0;
     q->rear = -1; // Set rear to -1 to indicate the queue is initially empty
     q->size = 0;
+    q->limits[NEW] = MAX_NEW_QUEUE;
+    q->limits[GOVERNMENT] = MAX_GOV_QUEUE;
+    q->limits[CHECKING] = MAX_CHECKING_QUEUE;
+    q->limits[SAVINGS] = MAX_SAVINGS_QUEUE;
 }
+
+/**
+ * Function name: setQueueLimits
+ * Description: Change the maximum number of customers per account type checked by isQueueFull.
+ * Parameters:
+ *** Queue *q: Pointer to the queue.
+ *** const int *limits: NUM_ACCOUNT_TYPES limits, indexed by account type.
+ */
+void setQueueLimits(Queue *q, const int *limits) {
+    memcpy(q->limits, limits, sizeof(q->limits));
+}
+/**
+ * Function name: isSizeFull
+ * Description: Check if a queue holding size transactions is full for the given account type.
+ * Parameters:
+ *** const Queue *q: Pointer to the queue, for its limits.
+ *** int size: Number of transactions in the queue.
+ *** int accountType: The type of account for the transaction.
+ * Return value:
+ *** int: Returns 1 if the queue is full, otherwise returns 0.
+ */
+static int isSizeFull(const Queue *q, int size, int accountType) {
+    if (size >= MAX_QUEUE_SIZE) {
+        return 1; // No room left in the ring buffer, whatever the account type
+    }
+    if (accountType < 0 || accountType >= NUM_ACCOUNT_TYPES) {
+        return 1; // Should never happen
+    }
+    return size >= q->limits[accountType]; // A mixed queue may already hold more than this type's limit
+}
+
 /**
  * Function name: isQueueFull
  * Description: Check if a queue is full based on the teller type.
@@ -24,18 +60,7 @@ void initQueue(Queue *q) {
  *** int: Returns 1 if the queue is full, otherwise returns 0.
  */
 int isQueueFull(Queue *q, int accountType) {
-    switch (accountType) {
-        case NEW:
-            return q->size == MAX_NEW_QUEUE;
-        case GOVERNMENT:
-            return q->size == MAX_GOV_QUEUE;
-        case CHECKING:
-            return q->size == MAX_CHECKING_QUEUE;
-        case SAVINGS:
-            return q->size == MAX_SAVINGS_QUEUE;
-        default:
-            return 1; // Should never happen
-    }
+    return isSizeFull(q, q->size, accountType);
 }
 
 /**
@@ -85,6 +110,129 @@ Transaction dequeue(Queue *q) {
     return transaction; // Return the dequeued transaction
 }
 
+/**
+ * Function name: removeFromQueue
+ * Description: Remove the transaction with the given stub number from anywhere in the queue.
+ *              Only the entries on the shorter side of it are shifted to close the gap.
+ * Parameters:
+ *** Queue *q: Pointer to the queue.
+ *** int stubNumber: Stub number of the transaction to remove.
+ *** Transaction *removed: Pointer to store the removed transaction, may be NULL.
+ * Return value:
+ *** int: Returns 1 if the transaction was found and removed, otherwise returns 0.
+ */
+int removeFromQueue(Queue *q, int stubNumber, Transaction *removed) {
+    int position = 0;
+    while (position < q->size && q->transactions[(q->front + position) % MAX_QUEUE_SIZE].stubNumber != stubNumber) {
+        position++;
+    }
+    if (position == q->size) {
+        return 0;
+    }
+    if (removed != NULL) {
+        *removed = q->transactions[(q->front + position) % MAX_QUEUE_SIZE];
+    }
+
+    if (position < q->size / 2) {
+        // Shift the entries in front of it one place towards the rear
+        for (int i = position; i > 0; i--) {
+            q->transactions[(q->front + i) % MAX_QUEUE_SIZE] = q->transactions[(q->front + i - 1) % MAX_QUEUE_SIZE];
+        }
+        q->front = (q->front + 1) % MAX_QUEUE_SIZE;
+    } else {
+        // Shift the entries behind it one place towards the front
+        for (int i = position; i < q->size - 1; i++) {
+            q->transactions[(q->front + i) % MAX_QUEUE_SIZE] = q->transactions[(q->front + i + 1) % MAX_QUEUE_SIZE];
+        }
+        q->rear = (q->rear - 1 + MAX_QUEUE_SIZE) % MAX_QUEUE_SIZE;
+    }
+    q->size--;
+    return 1;
+}
+
+/**
+ * Function name: enqueueBatch
+ * Description: Add several transactions to the queue with at most two memory copies.
+ *              Transactions are accepted in order until the first one that would not fit
+ *              the per-type limit, so the queue never reorders them.
+ * Parameters:
+ *** Queue *q: Pointer to the queue.
+ *** const Transaction *transactions: Array of transactions to be added.
+ *** int count: Number of transactions in the array.
+ * Return value:
+ *** int: The number of transactions accepted, from the start of the array.
+ */
+int enqueueBatch(Queue *q, const Transaction *transactions, int count) {
+    int accepted = 0;
+    while (accepted < count && !isSizeFull(q, q->size + accepted, transactions[accepted].accountType)) {
+        accepted++;
+    }
+    if (accepted == 0) {
+        return 0;
+    }
+
+    int start = (q->rear + 1) % MAX_QUEUE_SIZE;
+    int first = accepted < MAX_QUEUE_SIZE - start ? accepted : MAX_QUEUE_SIZE - start;
+    memcpy(&q->transactions[start], transactions, first * sizeof(Transaction));
+    memcpy(&q->transactions[0], transactions + first, (accepted - first) * sizeof(Transaction)); // Wrapped part
+    q->rear = (start + accepted - 1) % MAX_QUEUE_SIZE;
+    q->size += accepted;
+    return accepted;
+}
+
+/**
+ * Function name: peekBatch
+ * Description: Copy up to maxCount transactions from the front of the queue, with at most two
+ *              memory copies, without removing them.
+ * Parameters:
+ *** const Queue *q: Pointer to the queue.
+ *** Transaction *out: Array to store the transactions, oldest first.
+ *** int maxCount: Capacity of the out array.
+ * Return value:
+ *** int: The number of transactions copied.
+ */
+int peekBatch(const Queue *q, Transaction *out, int maxCount) {
+    int count = q->size < maxCount ? q->size : maxCount;
+    if (count <= 0) {
+        return 0;
+    }
+
+    int first = count < MAX_QUEUE_SIZE - q->front ? count : MAX_QUEUE_SIZE - q->front;
+    memcpy(out, &q->transactions[q->front], first * sizeof(Transaction));
+    memcpy(out + first, &q->transactions[0], (count - first) * sizeof(Transaction)); // Wrapped part
+    return count;
+}
+
+/**
+ * Function name: dequeueBatch
+ * Description: Remove up to maxCount transactions from the front of the queue with at most two memory copies.
+ * Parameters:
+ *** Queue *q: Pointer to the queue.
+ *** Transaction *out: Array to store the dequeued transactions, oldest first.
+ *** int maxCount: Capacity of the out array.
+ * Return value:
+ *** int: The number of transactions dequeued.
+ */
+int dequeueBatch(Queue *q, Transaction *out, int maxCount) {
+    int count = peekBatch(q, out, maxCount);
+    q->front = (q->front + count) % MAX_QUEUE_SIZE;
+    q->size -= count;
+    return count;
+}
+
+/**
+ * Function name: drainQueue
+ * Description: Remove every transaction from the queue.
+ * Parameters:
+ *** Queue *q: Pointer to the queue.
+ *** Transaction *out: Array with room for MAX_QUEUE_SIZE transactions, filled oldest first.
+ * Return value:
+ *** int: The number of transactions removed.
+ */
+int drainQueue(Queue *q, Transaction *out) {
+    return dequeueBatch(q, out, q->size);
+}
+
 /**
  * Function name: printQueueContents
  * Description: Print the contents of the queue.
@@ -105,4 +253,4 @@ void printQueueContents(Queue *q, const char *queueName) {
             i = (i + 1) % MAX_QUEUE_SIZE;
         }
     }
-}
\ No newline at end of file
+}
\ No newline at end of file
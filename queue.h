@@ -13,6 +13,7 @@
 #define GOVERNMENT 1
 #define CHECKING 2
 #define SAVINGS 3
+#define NUM_ACCOUNT_TYPES 4
 
 extern const char *accountTypeStr[];
 
@@ -28,14 +29,21 @@ typedef struct {
     int front; 
     int rear;  
     int size;  
+    int limits[NUM_ACCOUNT_TYPES]; // Queue size from which each account type is refused, MAX_NEW_QUEUE etc. by default
 } Queue;
 
 // Function declarations
 void initQueue(Queue *q);
+void setQueueLimits(Queue *q, const int *limits);
 int isQueueFull(Queue *q, int accountType);
 int isQueueEmpty(Queue *q);
 void enqueue(Queue *q, Transaction transaction);
 Transaction dequeue(Queue *q);
+int removeFromQueue(Queue *q, int stubNumber, Transaction *removed);
+int enqueueBatch(Queue *q, const Transaction *transactions, int count);
+int peekBatch(const Queue *q, Transaction *out, int maxCount);
+int dequeueBatch(Queue *q, Transaction *out, int maxCount);
+int drainQueue(Queue *q, Transaction *out);
 void printQueueContents(Queue *q, const char *queueName);
 
 #endif // QUEUE_H
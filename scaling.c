@@ -0,0 +1,67 @@
+#include "scaling.h"
+#include <stddef.h>
+#include <string.h>
+
+// Define the available policies, the first one is the default
+static const ScalingPolicy policies[] = {
+    { "adaptive", adaptiveDecision, SCALING_SMOOTHING, SCALING_OPEN_WAIT, SCALING_CLOSE_WAIT, SCALING_MIN_OPEN_TIME, LEGACY_PENDING_CONDITION },
+    { "legacy", legacyDecision, SCALING_SMOOTHING, 0.0, 0.0, 0, LEGACY_PENDING_CONDITION },
+};
+
+/**
+ * Function name: findScalingPolicy
+ * Description: Look up a scaling policy by name.
+ * Parameters:
+ *** const char *name: Name of the policy, or NULL for the default policy.
+ * Return value:
+ *** const ScalingPolicy *: The policy, or NULL if there is no policy with that name.
+ */
+const ScalingPolicy *findScalingPolicy(const char *name) {
+    if (name == NULL) {
+        return &policies[0];
+    }
+    for (size_t i = 0; i < sizeof(policies) / sizeof(policies[0]); i++) {
+        if (strcmp(policies[i].name, name) == 0) {
+            return &policies[i];
+        }
+    }
+    return NULL;
+}
+
+/**
+ * Function name: adaptiveDecision
+ * Description: Open the extra teller when the predicted wait rises above openWait and close it
+ *              again once the wait falls below closeWait and it has been open for minOpenTime.
+ *              The gap between the two thresholds keeps the teller from flapping.
+ * Parameters:
+ *** const ScalingPolicy *policy: Pointer to the policy parameters.
+ *** const ScalingSignals *signals: Pointer to the current signals.
+ * Return value:
+ *** int: SCALE_OPEN, SCALE_CLOSE or SCALE_KEEP.
+ */
+int adaptiveDecision(const ScalingPolicy *policy, const ScalingSignals *signals) {
+    if (signals->extraState != TELLER_OPEN) {
+        return signals->predictedWait > policy->openWait ? SCALE_OPEN : SCALE_KEEP;
+    }
+    if (signals->predictedWait < policy->closeWait && signals->openTime >= policy->minOpenTime) {
+        return SCALE_CLOSE;
+    }
+    return SCALE_KEEP;
+}
+
+/**
+ * Function name: legacyDecision
+ * Description: Open the extra teller when the checking and savings queues are full and the pending
+ *              queue holds at least pendingTrigger customers. Never closes it again.
+ * Parameters:
+ *** const ScalingPolicy *policy: Pointer to the policy parameters.
+ *** const ScalingSignals *signals: Pointer to the current signals.
+ * Return value:
+ *** int: SCALE_OPEN or SCALE_KEEP.
+ */
+int legacyDecision(const ScalingPolicy *policy, const ScalingSignals *signals) {
+    if (signals->extraState != TELLER_OPEN && signals->regularFull && signals->pendingSize >= policy->pendingTrigger) {
+        return SCALE_OPEN;
+    }
+    return SCALE_KEEP;
+}
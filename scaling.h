@@ -0,0 +1,56 @@
+#ifndef SCALING_H
+#define SCALING_H
+
+// Define the teller that can be opened and closed on demand
+#define EXTRA_TELLER 4
+
+// Define the states of the extra teller
+#define TELLER_CLOSED 0
+#define TELLER_OPEN 1
+#define TELLER_DRAINING 2 // Serves the customers already in its queue but takes no new ones
+
+// Define the scaling decisions
+#define SCALE_KEEP 0
+#define SCALE_OPEN 1
+#define SCALE_CLOSE -1
+
+// Define the default adaptive policy parameters
+#define SCALING_SMOOTHING 0.2
+#define SCALING_OPEN_WAIT 20.0
+#define SCALING_CLOSE_WAIT 8.0
+#define SCALING_MIN_OPEN_TIME 30
+#define SCALING_DEFAULT_SERVICE_TIME 8.0
+
+// The legacy policy opens when the pending queue holds half of MAX_EXTRA_QUEUE_TRANSACTIONS
+#define LEGACY_PENDING_CONDITION 5
+
+// Inputs a policy bases its decision on, refreshed every tick
+typedef struct {
+    int depth;              // Customers waiting in the regular and pending queues
+    int regularFull;        // 1 if the checking and savings queues are both full
+    int pendingSize;
+    double smoothedDepth;   // Exponentially smoothed depth
+    double predictedWait;   // Expected wait in minutes for a customer arriving now
+    int extraState;
+    int openTime;           // Minutes the extra teller has been open, 0 when closed
+} ScalingSignals;
+
+typedef struct ScalingPolicy ScalingPolicy;
+
+// Define a pluggable scaling policy
+struct ScalingPolicy {
+    const char *name;
+    int (*decide)(const ScalingPolicy *policy, const ScalingSignals *signals);
+    double smoothing;       // Weight of the newest depth sample
+    double openWait;        // Open when the predicted wait rises above this
+    double closeWait;       // Close when the predicted wait falls below this
+    int minOpenTime;        // Minimum minutes the extra teller stays open
+    int pendingTrigger;     // Pending queue size that opens the extra teller under the legacy policy
+};
+
+// Function declarations
+const ScalingPolicy *findScalingPolicy(const char *name);
+int adaptiveDecision(const ScalingPolicy *policy, const ScalingSignals *signals);
+int legacyDecision(const ScalingPolicy *policy, const ScalingSignals *signals);
+
+#endif // SCALING_H
@@ -0,0 +1,500 @@
+#define _GNU_SOURCE
+#include "server.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/epoll.h>
+#include <sys/signalfd.h>
+#include <sys/socket.h>
+#include <sys/timerfd.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#define ARRIVAL_RECORD_SIZE 5
+#define MAX_REPLY_SIZE (5 + 16 + NUM_TELLERS * 16) // Frame header plus the largest payload, the CMD_QUERY reply
+
+// An arrival waiting to be admitted into the simulation
+typedef struct {
+    int amount;
+    int accountType;
+} Arrival;
+
+// A connected client with its partially read request and unsent reply bytes
+typedef struct {
+    int fd;
+    unsigned char input[4 + SERVER_MAX_FRAME];
+    int inputLength;
+    unsigned char output[SERVER_OUTPUT_SIZE];
+    int outputLength;
+} Client;
+
+// Define the state of the ingestion server
+typedef struct {
+    Bank *bank;
+    int epollFd;
+    Client *clients[SERVER_MAX_CLIENTS];
+    Arrival ingest[SERVER_INGEST_CAPACITY]; // Ring buffer of arrivals not yet admitted
+    int ingestFront;
+    int ingestSize;
+} Server;
+
+/**
+ * Function name: putU32
+ * Description: Write a 32-bit big-endian integer.
+ * Parameters:
+ *** unsigned char *buffer: Destination buffer.
+ *** uint32_t value: The value to write.
+ */
+static void putU32(unsigned char *buffer, uint32_t value) {
+    buffer[0] = (unsigned char)(value >> 24);
+    buffer[1] = (unsigned char)(value >> 16);
+    buffer[2] = (unsigned char)(value >> 8);
+    buffer[3] = (unsigned char)value;
+}
+
+/**
+ * Function name: getU32
+ * Description: Read a 32-bit big-endian integer.
+ * Parameters:
+ *** const unsigned char *buffer: Source buffer.
+ * Return value:
+ *** uint32_t: The value read.
+ */
+static uint32_t getU32(const unsigned char *buffer) {
+    return ((uint32_t)buffer[0] << 24) | ((uint32_t)buffer[1] << 16) | ((uint32_t)buffer[2] << 8) | buffer[3];
+}
+
+/**
+ * Function name: closeClient
+ * Description: Disconnect a client and release its slot.
+ * Parameters:
+ *** Server *server: Pointer to the server.
+ *** int slot: Index of the client slot.
+ */
+static void closeClient(Server *server, int slot) {
+    Client *client = server->clients[slot];
+    epoll_ctl(server->epollFd, EPOLL_CTL_DEL, client->fd, NULL);
+    close(client->fd);
+    free(client);
+    server->clients[slot] = NULL;
+}
+
+/**
+ * Function name: flushClient
+ * Description: Send as much of a client's pending reply bytes as the socket accepts.
+ * Parameters:
+ *** Server *server: Pointer to the server.
+ *** int slot: Index of the client slot.
+ * Return value:
+ *** int: Returns 1 if the client is still usable, otherwise returns 0.
+ */
+static int flushClient(Server *server, int slot) {
+    Client *client = server->clients[slot];
+    int sent = 0;
+    while (sent < client->outputLength) {
+        // MSG_NOSIGNAL turns a write to a half-closed client into EPIPE instead of killing the server
+        ssize_t n = send(client->fd, client->output + sent, client->outputLength - sent, MSG_NOSIGNAL);
+        if (n < 0) {
+            if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                break;
+            }
+            return 0;
+        }
+        sent += (int)n;
+    }
+    memmove(client->output, client->output + sent, client->outputLength - sent);
+    client->outputLength -= sent;
+
+    // Stop reading once the input buffer is full of frames waiting for output room,
+    // and only ask for writability while there is something left to send
+    struct epoll_event event = { .events = 0, .data.u32 = (uint32_t)slot };
+    if (client->inputLength < (int)sizeof(client->input)) {
+        event.events |= EPOLLIN;
+    }
+    if (client->outputLength > 0) {
+        event.events |= EPOLLOUT;
+    }
+    epoll_ctl(server->epollFd, EPOLL_CTL_MOD, client->fd, &event);
+    return 1;
+}
+
+/**
+ * Function name: queueReply
+ * Description: Append a reply frame to a client's output buffer.
+ * Parameters:
+ *** Client *client: Pointer to the client.
+ *** int command: The command byte of the reply.
+ *** const unsigned char *payload: The reply payload.
+ *** int length: The payload length.
+ * Return value:
+ *** int: Returns 1 on success, or 0 if the client is not reading its replies.
+ */
+static int queueReply(Client *client, int command, const unsigned char *payload, int length) {
+    if (client->outputLength + 5 + length > SERVER_OUTPUT_SIZE) {
+        return 0;
+    }
+    unsigned char *frame = client->output + client->outputLength;
+    putU32(frame, (uint32_t)(length + 1));
+    frame[4] = (unsigned char)command;
+    memcpy(frame + 5, payload, length);
+    client->outputLength += 5 + length;
+    return 1;
+}
+
+/**
+ * Function name: handleArrivals
+ * Description: Copy a batch of arrivals into the ingestion buffer.
+ * Parameters:
+ *** Server *server: Pointer to the server.
+ *** Client *client: Pointer to the client that sent the batch.
+ *** const unsigned char *payload: The request payload.
+ *** int length: The payload length.
+ * Return value:
+ *** int: Returns 1 on success, otherwise returns 0.
+ */
+static int handleArrivals(Server *server, Client *client, const unsigned char *payload, int length) {
+    unsigned char reply[8];
+    // Compare without multiplying, a large count would wrap around and match a short payload
+    if (length < 4 || (length - 4) % ARRIVAL_RECORD_SIZE != 0 ||
+        getU32(payload) != (uint32_t)((length - 4) / ARRIVAL_RECORD_SIZE)) {
+        const char *message = "malformed arrival batch";
+        return queueReply(client, CMD_ERROR, (const unsigned char *)message, (int)strlen(message));
+    }
+
+    int count = (int)getU32(payload);
+    int accepted = 0;
+    const unsigned char *record = payload + 4;
+    for (; accepted < count && server->ingestSize < SERVER_INGEST_CAPACITY; accepted++) {
+        Arrival *arrival = &server->ingest[(server->ingestFront + server->ingestSize) % SERVER_INGEST_CAPACITY];
+        arrival->amount = (int)getU32(record);
+        arrival->accountType = record[4];
+        server->ingestSize++;
+        record += ARRIVAL_RECORD_SIZE;
+    }
+
+    putU32(reply, (uint32_t)accepted);
+    putU32(reply + 4, (uint32_t)server->ingestSize);
+    return queueReply(client, CMD_ARRIVALS, reply, sizeof(reply));
+}
+
+/**
+ * Function name: handleQuery
+ * Description: Reply with the current teller and queue state.
+ * Parameters:
+ *** Server *server: Pointer to the server.
+ *** Client *client: Pointer to the client.
+ * Return value:
+ *** int: Returns 1 on success, otherwise returns 0.
+ */
+static int handleQuery(Server *server, Client *client) {
+    unsigned char reply[16 + NUM_TELLERS * 16];
+    Bank *bank = server->bank;
+    putU32(reply, (uint32_t)bank->totalTimeElapsed);
+    putU32(reply + 4, (uint32_t)bank->pendingQueue.size);
+    putU32(reply + 8, (uint32_t)server->ingestSize);
+    putU32(reply + 12, NUM_TELLERS);
+    for (int i = 0; i < NUM_TELLERS; i++) {
+        unsigned char *teller = reply + 16 + i * 16;
+        putU32(teller, (uint32_t)bank->isBusy[i]);
+        putU32(teller + 4, (uint32_t)bank->remainingTime[i]);
+        putU32(teller + 8, (uint32_t)(bank->isBusy[i] ? bank->currentTransaction[i].stubNumber : 0));
+        putU32(teller + 12, (uint32_t)bank->tellers[i].size);
+    }
+    return queueReply(client, CMD_QUERY, reply, sizeof(reply));
+}
+
+/**
+ * Function name: countBalked
+ * Description: Count the customers of every account type who left without queueing.
+ * Parameters:
+ *** const Bank *bank: Pointer to the bank.
+ * Return value:
+ *** int: The number of balked customers.
+ */
+static int countBalked(const Bank *bank) {
+    int balked = 0;
+    for (int type = 0; type < NUM_ACCOUNT_TYPES; type++) {
+        balked += bank->balked[type];
+    }
+    return balked;
+}
+
+/**
+ * Function name: handleSummary
+ * Description: Reply with the completed transaction counters.
+ * Parameters:
+ *** Server *server: Pointer to the server.
+ *** Client *client: Pointer to the client.
+ * Return value:
+ *** int: Returns 1 on success, otherwise returns 0.
+ */
+static int handleSummary(Server *server, Client *client) {
+    unsigned char reply[28 + NUM_TELLERS * 8];
+    Bank *bank = server->bank;
+    putU32(reply, (uint32_t)bank->totalTimeElapsed);
+    putU32(reply + 4, (uint32_t)(bank->stubNumber - 1));
+    putU32(reply + 8, (uint32_t)bank->admitted);
+    putU32(reply + 12, (uint32_t)bank->rejected);
+    putU32(reply + 16, (uint32_t)countBalked(bank));
+    putU32(reply + 20, (uint32_t)bank->invalid);
+    putU32(reply + 24, NUM_TELLERS);
+    for (int i = 0; i < NUM_TELLERS; i++) {
+        putU32(reply + 28 + i * 8, (uint32_t)bank->completedCount[i]);
+        putU32(reply + 32 + i * 8, (uint32_t)bank->tellerTimes[i]);
+    }
+    return queueReply(client, CMD_SUMMARY, reply, sizeof(reply));
+}
+
+/**
+ * Function name: handleFrames
+ * Description: Handle the complete frames in a client's input buffer, as long as its output buffer
+ *              has room for their replies. The remaining frames wait until the client reads its replies.
+ * Parameters:
+ *** Server *server: Pointer to the server.
+ *** int slot: Index of the client slot.
+ * Return value:
+ *** int: Returns 1 if the client is still usable, otherwise returns 0.
+ */
+static int handleFrames(Server *server, int slot) {
+    Client *client = server->clients[slot];
+    int offset = 0;
+    while (client->inputLength - offset >= 4) {
+        uint32_t length = getU32(client->input + offset);
+        if (length == 0 || length > SERVER_MAX_FRAME) {
+            return 0;
+        }
+        if ((uint32_t)(client->inputLength - offset - 4) < length) {
+            break; // Wait for the rest of the frame
+        }
+        if (client->outputLength + MAX_REPLY_SIZE > SERVER_OUTPUT_SIZE) {
+            if (!flushClient(server, slot)) {
+                return 0;
+            }
+            if (client->outputLength + MAX_REPLY_SIZE > SERVER_OUTPUT_SIZE) {
+                break; // Wait for EPOLLOUT
+            }
+        }
+        const unsigned char *body = client->input + offset + 4;
+        int ok;
+        switch (body[0]) {
+            case CMD_ARRIVALS:
+                ok = handleArrivals(server, client, body + 1, (int)length - 1);
+                break;
+            case CMD_QUERY:
+                ok = handleQuery(server, client);
+                break;
+            case CMD_SUMMARY:
+                ok = handleSummary(server, client);
+                break;
+            default:
+                ok = queueReply(client, CMD_ERROR, (const unsigned char *)"unknown command", 15);
+        }
+        if (!ok) {
+            return 0;
+        }
+        offset += 4 + (int)length;
+    }
+    memmove(client->input, client->input + offset, client->inputLength - offset);
+    client->inputLength -= offset;
+    return 1;
+}
+
+/**
+ * Function name: readClient
+ * Description: Read available bytes from a client and handle every complete frame.
+ * Parameters:
+ *** Server *server: Pointer to the server.
+ *** int slot: Index of the client slot.
+ * Return value:
+ *** int: Returns 1 if the client is still usable, otherwise returns 0.
+ */
+static int readClient(Server *server, int slot) {
+    Client *client = server->clients[slot];
+    while (client->inputLength < (int)sizeof(client->input)) {
+        ssize_t n = read(client->fd, client->input + client->inputLength, sizeof(client->input) - client->inputLength);
+        if (n == 0) {
+            return 0;
+        }
+        if (n < 0) {
+            if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                break;
+            }
+            return 0;
+        }
+        client->inputLength += (int)n;
+        if (!handleFrames(server, slot)) {
+            return 0;
+        }
+    }
+    return flushClient(server, slot);
+}
+
+/**
+ * Function name: acceptClients
+ * Description: Accept every pending connection on the listening socket.
+ * Parameters:
+ *** Server *server: Pointer to the server.
+ *** int listenFd: The listening socket.
+ */
+static void acceptClients(Server *server, int listenFd) {
+    while (1) {
+        int fd = accept4(listenFd, NULL, NULL, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0) {
+            return;
+        }
+        int slot = 0;
+        while (slot < SERVER_MAX_CLIENTS && server->clients[slot] != NULL) {
+            slot++;
+        }
+        Client *client = slot < SERVER_MAX_CLIENTS ? (Client *)calloc(1, sizeof(Client)) : NULL;
+        if (client == NULL) {
+            close(fd);
+            continue;
+        }
+        client->fd = fd;
+        server->clients[slot] = client;
+        struct epoll_event event = { .events = EPOLLIN, .data.u32 = (uint32_t)slot };
+        epoll_ctl(server->epollFd, EPOLL_CTL_ADD, fd, &event);
+    }
+}
+
+/**
+ * Function name: runTicks
+ * Description: Admit buffered arrivals and advance the simulation for each elapsed tick.
+ * Parameters:
+ *** Server *server: Pointer to the server.
+ *** uint64_t ticks: Number of ticks to simulate.
+ */
+static void runTicks(Server *server, uint64_t ticks) {
+    for (uint64_t t = 0; t < ticks; t++) {
+        for (int i = 0; i < SERVER_ADMIT_PER_TICK && server->ingestSize > 0; i++) {
+            Arrival *arrival = &server->ingest[server->ingestFront];
+            addCustomer(server->bank, arrival->amount, arrival->accountType); // The bank counts how it went
+            server->ingestFront = (server->ingestFront + 1) % SERVER_INGEST_CAPACITY;
+            server->ingestSize--;
+        }
+        tickBank(server->bank);
+    }
+}
+
+/**
+ * Function name: runServer
+ * Description: Serve arrivals and queries on a Unix domain socket while the simulation
+ *              advances one tick every tickMillis milliseconds. Returns on SIGINT or SIGTERM.
+ * Parameters:
+ *** Bank *bank: Pointer to the bank to simulate.
+ *** const char *socketPath: Path of the Unix domain socket.
+ *** int tickMillis: Wall clock milliseconds per simulated minute.
+ * Return value:
+ *** int: Returns 0 on a clean shutdown, otherwise returns 1.
+ */
+int runServer(Bank *bank, const char *socketPath, int tickMillis) {
+    // Marker slots used in epoll data to tell the special descriptors apart from clients
+    enum { LISTEN_SLOT = SERVER_MAX_CLIENTS, TIMER_SLOT, SIGNAL_SLOT };
+    static Server server;
+    struct sockaddr_un address;
+    struct epoll_event event;
+    sigset_t signals;
+
+    memset(&server, 0, sizeof(server));
+    server.bank = bank;
+
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if (strlen(socketPath) >= sizeof(address.sun_path)) {
+        printf("|-[ ! ]- [ Socket path is too long: %s\n", socketPath);
+        return 1;
+    }
+    strcpy(address.sun_path, socketPath);
+    unlink(socketPath);
+
+    int listenFd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (listenFd < 0 || bind(listenFd, (struct sockaddr *)&address, sizeof(address)) != 0 || listen(listenFd, SOMAXCONN) != 0) {
+        printf("|-[ ! ]- [ Cannot listen on %s: %s\n", socketPath, strerror(errno));
+        return 1;
+    }
+
+    int timerFd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+    struct itimerspec interval;
+    if (tickMillis < 1) {
+        tickMillis = 1;
+    }
+    interval.it_interval.tv_sec = tickMillis / 1000;
+    interval.it_interval.tv_nsec = (long)(tickMillis % 1000) * 1000000L;
+    interval.it_value = interval.it_interval;
+    timerfd_settime(timerFd, 0, &interval, NULL);
+
+    sigemptyset(&signals);
+    sigaddset(&signals, SIGINT);
+    sigaddset(&signals, SIGTERM);
+    sigprocmask(SIG_BLOCK, &signals, NULL);
+    int signalFd = signalfd(-1, &signals, SFD_NONBLOCK | SFD_CLOEXEC);
+
+    server.epollFd = epoll_create1(EPOLL_CLOEXEC);
+    event.events = EPOLLIN;
+    event.data.u32 = LISTEN_SLOT;
+    epoll_ctl(server.epollFd, EPOLL_CTL_ADD, listenFd, &event);
+    event.data.u32 = TIMER_SLOT;
+    epoll_ctl(server.epollFd, EPOLL_CTL_ADD, timerFd, &event);
+    event.data.u32 = SIGNAL_SLOT;
+    epoll_ctl(server.epollFd, EPOLL_CTL_ADD, signalFd, &event);
+
+    printf("|-[ ! ]-[ Listening on %s, %d ms per simulated minute\n", socketPath, tickMillis);
+    fflush(stdout);
+
+    int running = 1;
+    while (running) {
+        struct epoll_event events[SERVER_MAX_CLIENTS + 3];
+        int count = epoll_wait(server.epollFd, events, SERVER_MAX_CLIENTS + 3, -1);
+        if (count < 0 && errno != EINTR) {
+            break;
+        }
+        for (int i = 0; i < count; i++) {
+            uint32_t slot = events[i].data.u32;
+            if (slot == LISTEN_SLOT) {
+                acceptClients(&server, listenFd);
+            } else if (slot == TIMER_SLOT) {
+                uint64_t expirations;
+                if (read(timerFd, &expirations, sizeof(expirations)) == sizeof(expirations)) {
+                    runTicks(&server, expirations);
+                }
+            } else if (slot == SIGNAL_SLOT) {
+                running = 0;
+            } else if (server.clients[slot] != NULL) {
+                int ok = 1;
+                if (events[i].events & EPOLLIN) {
+                    ok = readClient(&server, (int)slot);
+                }
+                if (ok && (events[i].events & (EPOLLHUP | EPOLLERR))) {
+                    ok = 0;
+                }
+                if (ok && (events[i].events & EPOLLOUT)) {
+                    // Room in the output buffer lets the frames that were held back go on
+                    ok = flushClient(&server, (int)slot) && handleFrames(&server, (int)slot) &&
+                         flushClient(&server, (int)slot);
+                }
+                if (!ok) {
+                    closeClient(&server, (int)slot);
+                }
+            }
+        }
+    }
+
+    for (int i = 0; i < SERVER_MAX_CLIENTS; i++) {
+        if (server.clients[i] != NULL) {
+            closeClient(&server, i);
+        }
+    }
+    close(server.epollFd);
+    close(signalFd);
+    close(timerFd);
+    close(listenFd);
+    unlink(socketPath);
+    printf("|-[ ! ]-[ Server stopped at minute %d, %d arrivals: %d admitted, %d rejected, %d balked, %d invalid\n",
+           bank->totalTimeElapsed, bank->stubNumber - 1, bank->admitted, bank->rejected, countBalked(bank), bank->invalid);
+    return 0;
+}
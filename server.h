@@ -0,0 +1,39 @@
+#ifndef SERVER_H
+#define SERVER_H
+
+#include "bank.h"
+
+// Define the server limits
+#define SERVER_MAX_CLIENTS 64
+#define SERVER_MAX_FRAME 65536
+#define SERVER_OUTPUT_SIZE 8192
+#define SERVER_INGEST_CAPACITY 65536
+#define SERVER_ADMIT_PER_TICK 64
+#define SERVER_DEFAULT_TICK_MS 10
+
+/*
+ * Wire protocol: every message is a frame made of a 32-bit big-endian body length
+ * followed by the body. The first byte of the body is the command, all integers
+ * in the payload are 32-bit big-endian.
+ *
+ *   CMD_ARRIVALS  request:  count, then count x (amount, 1-byte account type)
+ *                 reply:    accepted, backlog
+ *   CMD_QUERY     request:  empty
+ *                 reply:    time, pending size, backlog, numTellers,
+ *                           numTellers x (busy, remaining time, current stub, queue size)
+ *   CMD_SUMMARY   request:  empty
+ *                 reply:    time, arrivals, admitted, rejected, balked, invalid, numTellers,
+ *                           numTellers x (completed transactions, busy minutes)
+ *                 Every arrival is counted once: admitted into a queue, rejected because every
+ *                 queue was full, balked (--abandon only) or invalid because of its account type.
+ *   CMD_ERROR     reply:    error message text
+ */
+#define CMD_ARRIVALS 1
+#define CMD_QUERY 2
+#define CMD_SUMMARY 3
+#define CMD_ERROR 255
+
+// Function declarations
+int runServer(Bank *bank, const char *socketPath, int tickMillis);
+
+#endif // SERVER_H
@@ -1,5 +1,6 @@
 #include "stack.h"
 #include <stdio.h>
+#include <string.h>
 
 /**
  * Function name: initStack
@@ -65,3 +66,59 @@ Transaction pop(Stack *s) {
     }
     return transaction;
 }
+
+/**
+ * Function name: pushBatch
+ * Description: Add several transactions to the stack with one memory copy.
+ *              The last transaction of the array ends up on top.
+ * Parameters:
+ *** Stack *s: Pointer to the stack.
+ *** const Transaction *transactions: Array of transactions to be added.
+ *** int count: Number of transactions in the array.
+ * Return value:
+ *** int: The number of transactions accepted, from the start of the array.
+ */
+int pushBatch(Stack *s, const Transaction *transactions, int count) {
+    int room = MAX_STACK_SIZE - 1 - s->top;
+    int accepted = count < room ? count : room;
+    if (accepted <= 0) {
+        return 0;
+    }
+    memcpy(&s->transactions[s->top + 1], transactions, accepted * sizeof(Transaction));
+    s->top += accepted;
+    return accepted;
+}
+
+/**
+ * Function name: popBatch
+ * Description: Remove up to maxCount transactions from the top of the stack with one memory copy.
+ * Parameters:
+ *** Stack *s: Pointer to the stack.
+ *** Transaction *out: Array to store the popped transactions in stack order, so the
+ ***                   former top is the last element.
+ *** int maxCount: Capacity of the out array.
+ * Return value:
+ *** int: The number of transactions popped.
+ */
+int popBatch(Stack *s, Transaction *out, int maxCount) {
+    int count = s->top + 1 < maxCount ? s->top + 1 : maxCount;
+    if (count <= 0) {
+        return 0;
+    }
+    s->top -= count;
+    memcpy(out, &s->transactions[s->top + 1], count * sizeof(Transaction));
+    return count;
+}
+
+/**
+ * Function name: drainStack
+ * Description: Remove every transaction from the stack.
+ * Parameters:
+ *** Stack *s: Pointer to the stack.
+ *** Transaction *out: Array with room for MAX_STACK_SIZE transactions, filled bottom first.
+ * Return value:
+ *** int: The number of transactions removed.
+ */
+int drainStack(Stack *s, Transaction *out) {
+    return popBatch(s, out, s->top + 1);
+}
@@ -18,5 +18,8 @@ int isStackFull(Stack *s);
 int isStackEmpty(Stack *s);
 void push(Stack *s, Transaction transaction);
 Transaction pop(Stack *s);
+int pushBatch(Stack *s, const Transaction *transactions, int count);
+int popBatch(Stack *s, Transaction *out, int maxCount);
+int drainStack(Stack *s, Transaction *out);
 
 #endif // STACK_H
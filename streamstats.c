@@ -0,0 +1,311 @@
+#include "streamstats.h"
+#include "encoding.h"
+#include <dirent.h>
+#include <errno.h>
+#include <string.h>
+#include <sys/stat.h>
+
+#define SEGMENT_MAGIC "CCSG"
+#define SEGMENT_VERSION 1
+#define SEGMENT_RECORD_BYTES (4 * MAX_VARINT_BYTES + 1)
+#define SEGMENT_BUFFER_SIZE (16 + STREAM_SPILL_RECORDS * SEGMENT_RECORD_BYTES)
+
+/**
+ * Function name: resetWindow
+ * Description: Clear a stats window and assign it a new window number.
+ * Parameters:
+ *** StatsWindow *window: Pointer to the window to reset.
+ *** int windowIndex: The window number the slot will hold.
+ */
+static void resetWindow(StatsWindow *window, int windowIndex) {
+    memset(window, 0, sizeof(*window));
+    window->windowIndex = windowIndex;
+}
+
+/**
+ * Function name: addToAggregate
+ * Description: Add a single transaction to an aggregate.
+ * Parameters:
+ *** Aggregate *aggregate: Pointer to the aggregate.
+ *** Transaction *transaction: Pointer to the completed transaction.
+ */
+static void addToAggregate(Aggregate *aggregate, Transaction *transaction) {
+    aggregate->count++;
+    aggregate->totalAmount += transaction->amount;
+    aggregate->totalDuration += transaction->duration;
+}
+
+/**
+ * Function name: addToWindow
+ * Description: Add a completion record to every aggregate of a window.
+ * Parameters:
+ *** StatsWindow *window: Pointer to the window.
+ *** CompletionRecord *record: Pointer to the completion record.
+ */
+static void addToWindow(StatsWindow *window, CompletionRecord *record) {
+    addToAggregate(&window->total, &record->transaction);
+    if (record->teller >= 0 && record->teller < NUM_TELLERS) {
+        addToAggregate(&window->perTeller[record->teller], &record->transaction);
+    }
+    if (record->transaction.accountType >= 0 && record->transaction.accountType < NUM_ACCOUNT_TYPES) {
+        addToAggregate(&window->perAccountType[record->transaction.accountType], &record->transaction);
+    }
+}
+
+/**
+ * Function name: findNextSegment
+ * Description: Find the number following the highest segment file already in the spill directory.
+ * Parameters:
+ *** const char *spillDir: The spill directory.
+ * Return value:
+ *** int: The number of the first segment this run may write, or -1 if the directory cannot be read.
+ */
+static int findNextSegment(const char *spillDir) {
+    DIR *dir = opendir(spillDir);
+    if (dir == NULL) {
+        return -1;
+    }
+    int next = 0;
+    struct dirent *entry;
+    while ((entry = readdir(dir)) != NULL) {
+        int number;
+        char end;
+        if (sscanf(entry->d_name, "segment-%d.se%c", &number, &end) == 2 && end == 'g' && number >= next) {
+            next = number + 1;
+        }
+    }
+    closedir(dir);
+    return next;
+}
+
+/**
+ * Function name: initStreamStats
+ * Description: Initialize streaming statistics and create the spill directory if needed.
+ *              Segments already in the directory are kept, new ones are numbered after them.
+ * Parameters:
+ *** StreamStats *stats: Pointer to the statistics to initialize.
+ *** const char *spillDir: Directory where segment files are written.
+ * Return value:
+ *** int: Returns 1 on success, otherwise returns 0.
+ */
+int initStreamStats(StreamStats *stats, const char *spillDir) {
+    memset(stats, 0, sizeof(*stats));
+    for (int i = 0; i < STREAM_NUM_WINDOWS; i++) {
+        stats->windows[i].windowIndex = -1;
+    }
+    snprintf(stats->spillDir, sizeof(stats->spillDir), "%s", spillDir);
+    if (mkdir(spillDir, 0755) != 0 && errno != EEXIST) {
+        printf("|-[ ! ]- [ Cannot create spill directory %s\n", spillDir);
+        return 0;
+    }
+
+    // EEXIST is also reported for a regular file of that name, so check what is actually there
+    struct stat info;
+    if (stat(spillDir, &info) != 0 || !S_ISDIR(info.st_mode)) {
+        printf("|-[ ! ]- [ Spill path %s is not a directory\n", spillDir);
+        return 0;
+    }
+    stats->firstSegment = findNextSegment(spillDir);
+    if (stats->firstSegment < 0) {
+        printf("|-[ ! ]- [ Cannot read spill directory %s\n", spillDir);
+        return 0;
+    }
+    return 1;
+}
+
+/**
+ * Function name: recordCompletion
+ * Description: Fold a completed transaction into the rolling aggregates and buffer it for spilling.
+ * Parameters:
+ *** StreamStats *stats: Pointer to the statistics.
+ *** CompletionRecord record: The completed transaction.
+ */
+void recordCompletion(StreamStats *stats, CompletionRecord record) {
+    int windowIndex = record.completedAt / STREAM_WINDOW_MINUTES;
+    StatsWindow *window = &stats->windows[windowIndex % STREAM_NUM_WINDOWS];
+    if (window->windowIndex != windowIndex) {
+        resetWindow(window, windowIndex); // Evict the window that used to occupy this slot
+    }
+    addToWindow(window, &record);
+    addToWindow(&stats->lifetime, &record);
+
+    stats->pending[stats->pendingCount++] = record;
+    if (stats->pendingCount == STREAM_SPILL_RECORDS && !spillPending(stats)) {
+        // The aggregates already hold these records, only the raw copies are lost
+        stats->droppedRecords += stats->pendingCount;
+        stats->pendingCount = 0;
+    }
+}
+
+/**
+ * Function name: spillPending
+ * Description: Write the buffered raw records to a new delta/varint encoded segment file.
+ * Parameters:
+ *** StreamStats *stats: Pointer to the statistics.
+ * Return value:
+ *** int: Returns 1 on success or if there was nothing to spill, otherwise returns 0.
+ */
+int spillPending(StreamStats *stats) {
+    static unsigned char buffer[SEGMENT_BUFFER_SIZE];
+    char path[STREAM_PATH_SIZE + 32];
+    int length = 0;
+    int prevStub = 0;
+    int prevTime = 0;
+
+    if (stats->pendingCount == 0) {
+        return 1;
+    }
+
+    memcpy(buffer, SEGMENT_MAGIC, 4);
+    length = 4;
+    buffer[length++] = SEGMENT_VERSION;
+    length += putVarint(buffer + length, (unsigned long long)stats->pendingCount);
+
+    for (int i = 0; i < stats->pendingCount; i++) {
+        CompletionRecord *record = &stats->pending[i];
+        length += putVarint(buffer + length, zigzagEncode(record->transaction.stubNumber - prevStub));
+        length += putVarint(buffer + length, zigzagEncode(record->completedAt - prevTime));
+        length += putVarint(buffer + length, zigzagEncode(record->transaction.amount));
+        length += putVarint(buffer + length, zigzagEncode(record->transaction.duration));
+        buffer[length++] = (unsigned char)((record->transaction.accountType & 0x3) | (record->teller << 2));
+        prevStub = record->transaction.stubNumber;
+        prevTime = record->completedAt;
+    }
+
+    snprintf(path, sizeof(path), "%s/segment-%06d.seg", stats->spillDir, stats->firstSegment + stats->segmentCount);
+    FILE *file = fopen(path, "wb");
+    if (file == NULL) {
+        printf("|-[ ! ]- [ Cannot open segment file %s\n", path);
+        return 0;
+    }
+    int written = (int)fwrite(buffer, 1, length, file);
+    fclose(file);
+    if (written != length) {
+        printf("|-[ ! ]- [ Short write to segment file %s\n", path);
+        return 0;
+    }
+
+    stats->segmentCount++;
+    stats->spilledRecords += stats->pendingCount;
+    stats->spilledBytes += length;
+    stats->pendingCount = 0;
+    return 1;
+}
+
+/**
+ * Function name: readSegment
+ * Description: Decode a segment file written by spillPending.
+ * Parameters:
+ *** const char *path: Path of the segment file.
+ *** CompletionRecord *records: Array to store the decoded records.
+ *** int maxRecords: Capacity of the records array.
+ * Return value:
+ *** int: The number of records decoded, or -1 if the file is unreadable or corrupt.
+ */
+int readSegment(const char *path, CompletionRecord *records, int maxRecords) {
+    static unsigned char buffer[SEGMENT_BUFFER_SIZE];
+    unsigned long long value;
+    int stub = 0;
+    int time = 0;
+    int pos, used;
+
+    FILE *file = fopen(path, "rb");
+    if (file == NULL) {
+        return -1;
+    }
+    int length = (int)fread(buffer, 1, sizeof(buffer), file);
+    fclose(file);
+
+    if (length < 6 || memcmp(buffer, SEGMENT_MAGIC, 4) != 0 || buffer[4] != SEGMENT_VERSION) {
+        return -1;
+    }
+    pos = 5;
+    if ((used = getVarint(buffer + pos, length - pos, &value)) == 0) {
+        return -1;
+    }
+    pos += used;
+    int count = (int)value;
+    if (count > maxRecords) {
+        count = maxRecords;
+    }
+
+    for (int i = 0; i < count; i++) {
+        long long fields[4];
+        for (int f = 0; f < 4; f++) {
+            if ((used = getVarint(buffer + pos, length - pos, &value)) == 0) {
+                return -1;
+            }
+            pos += used;
+            fields[f] = zigzagDecode(value);
+        }
+        if (pos >= length) {
+            return -1;
+        }
+        stub += (int)fields[0];
+        time += (int)fields[1];
+        records[i].transaction.stubNumber = stub;
+        records[i].transaction.amount = (int)fields[2];
+        records[i].transaction.duration = (int)fields[3];
+        records[i].transaction.accountType = buffer[pos] & 0x3;
+        records[i].teller = buffer[pos] >> 2;
+        records[i].completedAt = time;
+        pos++;
+    }
+    return count;
+}
+
+/**
+ * Function name: printAggregate
+ * Description: Print one aggregate line.
+ * Parameters:
+ *** const char *label: Label printed in front of the values.
+ *** Aggregate *aggregate: Pointer to the aggregate.
+ */
+static void printAggregate(const char *label, Aggregate *aggregate) {
+    printf("|-[ ! ]-[ %-12s | Transactions: %d, Total Amount: %lld, Average Time: %lld minutes\n",
+           label, aggregate->count, aggregate->totalAmount,
+           aggregate->count > 0 ? aggregate->totalDuration / aggregate->count : 0);
+}
+
+/**
+ * Function name: printStreamSummary
+ * Description: Display the current window, the lifetime aggregates and the spill status.
+ * Parameters:
+ *** StreamStats *stats: Pointer to the statistics.
+ *** int currentTime: The current simulation time in minutes.
+ */
+void printStreamSummary(StreamStats *stats, int currentTime) {
+    int windowIndex = currentTime / STREAM_WINDOW_MINUTES;
+    StatsWindow *window = &stats->windows[windowIndex % STREAM_NUM_WINDOWS];
+    char label[20];
+
+    printf("\n|=============================================[ Streaming Summary ]================================================|\n");
+    if (window->windowIndex == windowIndex) {
+        printf("|-[ ! ]-[ Current window (hour %d):\n", windowIndex);
+        printAggregate("All", &window->total);
+        for (int i = 0; i < NUM_TELLERS; i++) {
+            snprintf(label, sizeof(label), "Teller %d", i + 1);
+            printAggregate(label, &window->perTeller[i]);
+        }
+        for (int i = 0; i < NUM_ACCOUNT_TYPES; i++) {
+            printAggregate(accountTypeStr[i], &window->perAccountType[i]);
+        }
+    } else {
+        printf("|-[ ! ]-[ No completed transactions in the current window (hour %d).\n", windowIndex);
+    }
+
+    printf("|-[ ! ]-[ Lifetime:\n");
+    printAggregate("All", &stats->lifetime.total);
+    for (int i = 0; i < NUM_TELLERS; i++) {
+        snprintf(label, sizeof(label), "Teller %d", i + 1);
+        printAggregate(label, &stats->lifetime.perTeller[i]);
+    }
+    for (int i = 0; i < NUM_ACCOUNT_TYPES; i++) {
+        printAggregate(accountTypeStr[i], &stats->lifetime.perAccountType[i]);
+    }
+    printf("|-[ ! ]-[ Spilled %lld records in %d segments (%lld bytes), %d records buffered\n",
+           stats->spilledRecords, stats->segmentCount, stats->spilledBytes, stats->pendingCount);
+    if (stats->droppedRecords > 0) {
+        printf("|-[ ! ]-[ Dropped %lld records that could not be spilled\n", stats->droppedRecords);
+    }
+}
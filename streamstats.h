@@ -0,0 +1,57 @@
+#ifndef STREAMSTATS_H
+#define STREAMSTATS_H
+
+#include <stdio.h>
+#include "queue.h"
+#include "transaction.h"
+
+// Define the rolling window layout and the memory budget for raw records
+#define STREAM_WINDOW_MINUTES 60
+#define STREAM_NUM_WINDOWS 24
+#define STREAM_SPILL_RECORDS 256
+#define STREAM_PATH_SIZE 256
+
+// A completed transaction together with where and when it finished
+typedef struct {
+    Transaction transaction;
+    int teller;
+    int completedAt;
+} CompletionRecord;
+
+// Running totals for one group of completed transactions
+typedef struct {
+    int count;
+    long long totalAmount;
+    long long totalDuration;
+} Aggregate;
+
+// Aggregates for a single window of simulated time
+typedef struct {
+    int windowIndex; // Window number held in this slot, -1 if unused
+    Aggregate total;
+    Aggregate perTeller[NUM_TELLERS];
+    Aggregate perAccountType[NUM_ACCOUNT_TYPES];
+} StatsWindow;
+
+// Define a fixed-size streaming statistics structure
+typedef struct {
+    StatsWindow windows[STREAM_NUM_WINDOWS];
+    StatsWindow lifetime;
+    CompletionRecord pending[STREAM_SPILL_RECORDS]; // Raw records waiting to be spilled
+    int pendingCount;
+    int firstSegment; // Number of the first segment written by this run
+    int segmentCount; // Segments written by this run
+    long long spilledRecords;
+    long long spilledBytes;
+    long long droppedRecords; // Raw records discarded because their segment could not be written
+    char spillDir[STREAM_PATH_SIZE];
+} StreamStats;
+
+// Function declarations
+int initStreamStats(StreamStats *stats, const char *spillDir);
+void recordCompletion(StreamStats *stats, CompletionRecord record);
+int spillPending(StreamStats *stats);
+void printStreamSummary(StreamStats *stats, int currentTime);
+int readSegment(const char *path, CompletionRecord *records, int maxRecords);
+
+#endif // STREAMSTATS_H
@@ -0,0 +1,99 @@
+#include "tellerkernel.h"
+#include <string.h>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define TELLER_VECTOR_WIDTH 8
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#define TELLER_VECTOR_WIDTH 4
+#else
+#define TELLER_VECTOR_WIDTH 1
+#endif
+
+/**
+ * Function name: updateTellers
+ * Description: Let every busy teller work one minute in a single pass. Remaining times are decremented,
+ *              busy times accumulated, and tellers whose transaction finished are marked idle.
+ * Parameters:
+ *** int *remainingTime: Remaining minutes of the current transaction of each teller.
+ *** int *isBusy: 1 for each teller serving a transaction, otherwise 0.
+ *** int *busyTime: Accumulated busy minutes of each teller.
+ *** int count: Number of tellers.
+ *** unsigned int *completedMask: Receives one bit per teller that completed its transaction,
+ ***                              TELLER_MASK_WORDS(count) words.
+ * Return value:
+ *** int: The number of tellers that completed their transaction.
+ */
+int updateTellers(int *remainingTime, int *isBusy, int *busyTime, int count, unsigned int *completedMask) {
+    int completed = 0;
+    int i = 0;
+
+    memset(completedMask, 0, TELLER_MASK_WORDS(count) * sizeof(unsigned int));
+
+#if TELLER_VECTOR_WIDTH == 8
+    const __m256i zero8 = _mm256_setzero_si256();
+    for (; i + 8 <= count; i += 8) {
+        __m256i busy = _mm256_loadu_si256((const __m256i *)(isBusy + i));
+        __m256i active = _mm256_cmpgt_epi32(busy, zero8); // -1 in every busy lane
+        __m256i remaining = _mm256_add_epi32(_mm256_loadu_si256((const __m256i *)(remainingTime + i)), active);
+        __m256i time = _mm256_sub_epi32(_mm256_loadu_si256((const __m256i *)(busyTime + i)), active);
+        __m256i done = _mm256_and_si256(active, _mm256_cmpeq_epi32(remaining, zero8));
+        _mm256_storeu_si256((__m256i *)(remainingTime + i), remaining);
+        _mm256_storeu_si256((__m256i *)(busyTime + i), time);
+        _mm256_storeu_si256((__m256i *)(isBusy + i), _mm256_andnot_si256(done, busy));
+        unsigned int bits = (unsigned int)_mm256_movemask_ps(_mm256_castsi256_ps(done));
+        completedMask[i / TELLER_MASK_BITS] |= bits << (i % TELLER_MASK_BITS);
+        completed += __builtin_popcount(bits);
+    }
+#endif
+#if TELLER_VECTOR_WIDTH >= 4
+    // AVX2 builds fall through to here as well, so fewer than 8 remaining tellers still get a 4-wide pass
+    const __m128i zero4 = _mm_setzero_si128();
+    for (; i + 4 <= count; i += 4) {
+        __m128i busy = _mm_loadu_si128((const __m128i *)(isBusy + i));
+        __m128i active = _mm_cmpgt_epi32(busy, zero4); // -1 in every busy lane
+        __m128i remaining = _mm_add_epi32(_mm_loadu_si128((const __m128i *)(remainingTime + i)), active);
+        __m128i time = _mm_sub_epi32(_mm_loadu_si128((const __m128i *)(busyTime + i)), active);
+        __m128i done = _mm_and_si128(active, _mm_cmpeq_epi32(remaining, zero4));
+        _mm_storeu_si128((__m128i *)(remainingTime + i), remaining);
+        _mm_storeu_si128((__m128i *)(busyTime + i), time);
+        _mm_storeu_si128((__m128i *)(isBusy + i), _mm_andnot_si128(done, busy));
+        unsigned int bits = (unsigned int)_mm_movemask_ps(_mm_castsi128_ps(done));
+        completedMask[i / TELLER_MASK_BITS] |= bits << (i % TELLER_MASK_BITS);
+        completed += __builtin_popcount(bits);
+    }
+#endif
+
+    // Scalar fallback, also used for the tellers left over after the last full vector
+    for (; i < count; i++) {
+        int active = isBusy[i] > 0;
+        remainingTime[i] -= active;
+        busyTime[i] += active;
+        int done = active & (remainingTime[i] == 0);
+        isBusy[i] = active & !done;
+        completedMask[i / TELLER_MASK_BITS] |= (unsigned int)done << (i % TELLER_MASK_BITS);
+        completed += done;
+    }
+    return completed;
+}
+
+/**
+ * Function name: nextCompletedTeller
+ * Description: Take the lowest teller out of a completion mask.
+ * Parameters:
+ *** unsigned int *completedMask: The completion mask filled by updateTellers.
+ *** int words: Number of words in the mask.
+ * Return value:
+ *** int: The index of the teller, or -1 when the mask is empty.
+ */
+int nextCompletedTeller(unsigned int *completedMask, int words) {
+    for (int w = 0; w < words; w++) {
+        unsigned int word = completedMask[w];
+        if (word != 0) {
+            completedMask[w] = word & (word - 1);
+            return w * TELLER_MASK_BITS + __builtin_ctz(word);
+        }
+    }
+    return -1;
+}
@@ -0,0 +1,21 @@
+#ifndef TELLERKERNEL_H
+#define TELLERKERNEL_H
+
+// Define how many tellers one completion mask word covers
+#define TELLER_MASK_BITS 32
+#define TELLER_MASK_WORDS(count) (((count) + TELLER_MASK_BITS - 1) / TELLER_MASK_BITS)
+
+/*
+ * The kernel works on teller state kept as separate arrays (structure of arrays).
+ * It uses AVX2 when compiled with -mavx2, SSE2 on any other x86-64 build, and a
+ * branch-free scalar loop everywhere else. AVX2 builds finish with one SSE2 pass
+ * when 4 or more tellers are left, and the scalar loop takes whatever remains.
+ * With the 5 tellers of the bank the AVX2 loop never runs: SSE2 updates tellers
+ * 1 to 4 and the scalar loop updates the 5th.
+ */
+
+// Function declarations
+int updateTellers(int *remainingTime, int *isBusy, int *busyTime, int count, unsigned int *completedMask);
+int nextCompletedTeller(unsigned int *completedMask, int words);
+
+#endif // TELLERKERNEL_H
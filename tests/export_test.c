@@ -0,0 +1,132 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "../export.h"
+
+#define TEST_ROWS (2 * EXPORT_CHUNK_ROWS + 123)
+
+static int failures = 0;
+
+/**
+ * Function name: check
+ * Description: Report a failed expectation.
+ * Parameters:
+ *** int condition: The expectation, nonzero if it holds.
+ *** const char *message: What was expected.
+ */
+static void check(int condition, const char *message) {
+    if (!condition) {
+        printf("|-[ ! ]- [ FAILED: %s\n", message);
+        failures++;
+    }
+}
+
+/**
+ * Function name: makeRecord
+ * Description: Build the i-th test record. Stub numbers and times move in both directions,
+ *              amounts are negative now and then and durations reach well past one byte.
+ * Parameters:
+ *** int i: Index of the record.
+ * Return value:
+ *** CompletionRecord: The record.
+ */
+static CompletionRecord makeRecord(int i) {
+    CompletionRecord record;
+    memset(&record, 0, sizeof(record));
+    record.transaction.stubNumber = 1 + i + (i % 3 == 0 ? -2 : 5);
+    record.transaction.amount = (i % 7 == 0 ? -1 : 1) * (i * 7919 % 1000003);
+    record.transaction.accountType = i % NUM_ACCOUNT_TYPES;
+    record.transaction.duration = i % 11 == 0 ? 1000 - i % 5 : 1 + i % 300;
+    record.transaction.arrivalTime = i / 3;
+    record.transaction.timerHandle = -1;
+    record.teller = i % NUM_TELLERS;
+    record.completedAt = i / 2 + record.transaction.duration;
+    return record;
+}
+
+/**
+ * Function name: readAll
+ * Description: Decode every chunk of an export file.
+ * Parameters:
+ *** const char *path: Path of the file.
+ *** CompletionRecord *rows: Array with room for TEST_ROWS + EXPORT_CHUNK_ROWS rows.
+ * Return value:
+ *** int: The number of rows decoded, or -1 if the file was rejected.
+ */
+static int readAll(const char *path, CompletionRecord *rows) {
+    static ExportReader reader;
+    int total = 0;
+    int count;
+    if (!openExportReader(&reader, path)) {
+        return -1;
+    }
+    while ((count = readExportChunk(&reader, rows + total)) > 0) {
+        total += count;
+    }
+    closeExportReader(&reader);
+    return count < 0 ? -1 : total;
+}
+
+int main(void) {
+    static Exporter exporter;
+    static CompletionRecord rows[TEST_ROWS + EXPORT_CHUNK_ROWS];
+    char path[] = "/tmp/export-test-XXXXXX";
+    int fd = mkstemp(path);
+    if (fd < 0) {
+        printf("|-[ ! ]- [ Cannot create %s\n", path);
+        return 1;
+    }
+    close(fd);
+
+    // Two full chunks and a partial one come back exactly, including durations past 255
+    check(openExporter(&exporter, path, NULL), "exporter opens");
+    for (int i = 0; i < TEST_ROWS; i++) {
+        CompletionRecord record = makeRecord(i);
+        exportCompletion(&exporter, &record);
+    }
+    check(closeExporter(&exporter), "exporter closes");
+
+    int count = readAll(path, rows);
+    check(count == TEST_ROWS, "every row decoded");
+    int matching = 0;
+    for (int i = 0; i < count && i < TEST_ROWS; i++) {
+        CompletionRecord expected = makeRecord(i);
+        matching += memcmp(&rows[i], &expected, sizeof(CompletionRecord)) == 0;
+    }
+    check(matching == TEST_ROWS, "rows round-trip, durations are not clamped");
+
+    // An empty export is just the header and the trailer
+    check(openExporter(&exporter, path, NULL) && closeExporter(&exporter), "empty export written");
+    check(readAll(path, rows) == 0, "empty export decodes to no rows");
+
+    // Truncation and a changed byte are both reported
+    check(openExporter(&exporter, path, NULL), "exporter reopens");
+    for (int i = 0; i < EXPORT_CHUNK_ROWS + 10; i++) {
+        CompletionRecord record = makeRecord(i);
+        exportCompletion(&exporter, &record);
+    }
+    check(closeExporter(&exporter), "exporter closes again");
+    FILE *file = fopen(path, "r+b");
+    fseek(file, 0, SEEK_END);
+    long length = ftell(file);
+    fseek(file, length - 5, SEEK_SET);
+    fputc(0x7F, file); // Row total in the trailer
+    fclose(file);
+    check(readAll(path, rows) == -1, "wrong trailer total rejected");
+    check(truncate(path, length / 2) == 0 && readAll(path, rows) == -1, "truncated export rejected");
+
+    file = fopen(path, "wb");
+    fputs("CCDX", file);
+    fputc(1, file); // Version 1 clamped durations, it is refused rather than misread
+    fclose(file);
+    check(readAll(path, rows) == -1, "older version rejected");
+
+    remove(path);
+    if (failures > 0) {
+        printf("|-[ ! ]- [ %d checks failed\n", failures);
+        return 1;
+    }
+    printf("|-[ ! ]-[ export: all checks passed\n");
+    return 0;
+}
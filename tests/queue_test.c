@@ -0,0 +1,164 @@
+#include <stdio.h>
+#include <string.h>
+#include "../queue.h"
+
+static int failures = 0;
+
+/**
+ * Function name: check
+ * Description: Report a failed expectation.
+ * Parameters:
+ *** int condition: The expectation, nonzero if it holds.
+ *** const char *message: What was expected.
+ */
+static void check(int condition, const char *message) {
+    if (!condition) {
+        printf("|-[ ! ]- [ FAILED: %s\n", message);
+        failures++;
+    }
+}
+
+/**
+ * Function name: makeTransaction
+ * Description: Build a transaction whose stub number identifies it.
+ * Parameters:
+ *** int stub: Stub number.
+ *** int accountType: The type of account.
+ * Return value:
+ *** Transaction: The transaction.
+ */
+static Transaction makeTransaction(int stub, int accountType) {
+    Transaction transaction;
+    memset(&transaction, 0, sizeof(transaction));
+    transaction.stubNumber = stub;
+    transaction.amount = stub * 10;
+    transaction.accountType = accountType;
+    transaction.duration = 1 + stub % 7;
+    return transaction;
+}
+
+/**
+ * Function name: sameQueue
+ * Description: Compare the contents and order of two queues.
+ * Parameters:
+ *** Queue *a: The first queue.
+ *** Queue *b: The second queue.
+ * Return value:
+ *** int: Returns 1 if both hold the same transactions in the same order, otherwise returns 0.
+ */
+static int sameQueue(Queue *a, Queue *b) {
+    if (a->size != b->size) {
+        return 0;
+    }
+    for (int i = 0; i < a->size; i++) {
+        Transaction *x = &a->transactions[(a->front + i) % MAX_QUEUE_SIZE];
+        Transaction *y = &b->transactions[(b->front + i) % MAX_QUEUE_SIZE];
+        if (memcmp(x, y, sizeof(Transaction)) != 0) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+int main(void) {
+    static const int roomy[NUM_ACCOUNT_TYPES] = { MAX_QUEUE_SIZE, MAX_QUEUE_SIZE, MAX_QUEUE_SIZE, MAX_QUEUE_SIZE };
+    Transaction batch[MAX_QUEUE_SIZE + 5];
+    Transaction out[MAX_QUEUE_SIZE + 5];
+    Queue batched, single;
+
+    // A batch that wraps around the end of the ring matches one enqueue per transaction
+    for (int offset = 0; offset < MAX_QUEUE_SIZE; offset += 7) {
+        initQueue(&batched);
+        initQueue(&single);
+        setQueueLimits(&batched, roomy);
+        setQueueLimits(&single, roomy);
+        for (int i = 0; i < offset; i++) {
+            enqueue(&batched, makeTransaction(0, NEW));
+            enqueue(&single, makeTransaction(0, NEW));
+        }
+        check(dequeueBatch(&batched, out, offset) == offset, "dequeueBatch moves the front");
+        for (int i = 0; i < offset; i++) {
+            dequeue(&single);
+        }
+
+        for (int i = 0; i < MAX_QUEUE_SIZE - 3; i++) {
+            batch[i] = makeTransaction(100 + i, i % NUM_ACCOUNT_TYPES);
+            enqueue(&single, batch[i]);
+        }
+        check(enqueueBatch(&batched, batch, MAX_QUEUE_SIZE - 3) == MAX_QUEUE_SIZE - 3, "wrapping batch accepted");
+        check(sameQueue(&batched, &single), "wrapping batch matches single enqueues");
+        check(batched.rear == single.rear, "wrapping batch leaves rear where single enqueues do");
+
+        // Reading back across the wrap, first a few at a time, then everything
+        int count = dequeueBatch(&batched, out, 5);
+        int ok = count == 5;
+        for (int i = 0; i < 5; i++) {
+            Transaction expected = dequeue(&single);
+            ok = ok && memcmp(&out[i], &expected, sizeof(Transaction)) == 0;
+        }
+        check(ok, "dequeueBatch matches single dequeues");
+        count = peekBatch(&batched, out, MAX_QUEUE_SIZE);
+        check(count == batched.size && out[0].stubNumber == 105, "peekBatch copies without removing");
+        count = drainQueue(&batched, out);
+        ok = count == MAX_QUEUE_SIZE - 8 && isQueueEmpty(&batched);
+        for (int i = 0; i < count; i++) {
+            Transaction expected = dequeue(&single);
+            ok = ok && memcmp(&out[i], &expected, sizeof(Transaction)) == 0;
+        }
+        check(ok && isQueueEmpty(&single), "drainQueue empties the queue oldest first");
+    }
+
+    // The ring itself caps a batch even when the limits do not
+    initQueue(&batched);
+    setQueueLimits(&batched, roomy);
+    for (int i = 0; i < MAX_QUEUE_SIZE + 5; i++) {
+        batch[i] = makeTransaction(i, SAVINGS);
+    }
+    check(enqueueBatch(&batched, batch, MAX_QUEUE_SIZE + 5) == MAX_QUEUE_SIZE, "batch capped at the ring size");
+
+    // Acceptance stops at the first transaction that hits its type limit, later ones are not considered
+    initQueue(&batched);
+    for (int i = 0; i < 8; i++) {
+        batch[i] = makeTransaction(i, CHECKING);
+    }
+    check(enqueueBatch(&batched, batch, 8) == MAX_CHECKING_QUEUE, "checking batch stops at its limit");
+    check(enqueueBatch(&batched, batch, 1) == 0, "full queue accepts nothing");
+
+    initQueue(&batched);
+    initQueue(&single);
+    batch[0] = makeTransaction(1, SAVINGS);
+    batch[1] = makeTransaction(2, SAVINGS);
+    batch[2] = makeTransaction(3, NEW);     // The queue holds MAX_NEW_QUEUE transactions here, so it is full for New
+    batch[3] = makeTransaction(4, SAVINGS); // Would fit, but must not overtake the rejected customer
+    enqueue(&single, makeTransaction(0, SAVINGS));
+    enqueue(&batched, makeTransaction(0, SAVINGS));
+    int accepted = enqueueBatch(&batched, batch, 4);
+    check(accepted == 2, "partial acceptance at the New limit");
+    for (int i = 0; i < 4 && !isQueueFull(&single, batch[i].accountType); i++) {
+        enqueue(&single, batch[i]);
+    }
+    check(sameQueue(&batched, &single), "partial batch matches single enqueues");
+
+    check(dequeueBatch(&batched, out, 0) == 0 && batched.size == 3, "empty dequeueBatch leaves the queue alone");
+    initQueue(&batched);
+    check(drainQueue(&batched, out) == 0, "draining an empty queue");
+
+    // A mixed queue that already holds more than a type's limit stays full for that type
+    initQueue(&batched);
+    for (int i = 0; i < MAX_NEW_QUEUE + 1; i++) {
+        enqueue(&batched, makeTransaction(i, SAVINGS));
+    }
+    check(isQueueFull(&batched, NEW) && !isQueueFull(&batched, SAVINGS), "queue past the New limit is full for New");
+    batch[0] = makeTransaction(10, NEW);
+    check(enqueueBatch(&batched, batch, 1) == 0, "batch refused past the New limit");
+    batch[0] = makeTransaction(10, SAVINGS);
+    batch[1] = makeTransaction(11, GOVERNMENT);
+    check(enqueueBatch(&batched, batch, 2) == 1, "batch stops at a Government limit the queue is already past");
+
+    if (failures > 0) {
+        printf("|-[ ! ]- [ %d checks failed\n", failures);
+        return 1;
+    }
+    printf("|-[ ! ]-[ queue: all checks passed\n");
+    return 0;
+}
@@ -0,0 +1,88 @@
+#include <stdio.h>
+#include <string.h>
+#include "../stack.h"
+
+static int failures = 0;
+
+/**
+ * Function name: check
+ * Description: Report a failed expectation.
+ * Parameters:
+ *** int condition: The expectation, nonzero if it holds.
+ *** const char *message: What was expected.
+ */
+static void check(int condition, const char *message) {
+    if (!condition) {
+        printf("|-[ ! ]- [ FAILED: %s\n", message);
+        failures++;
+    }
+}
+
+/**
+ * Function name: makeTransaction
+ * Description: Build a transaction whose stub number identifies it.
+ * Parameters:
+ *** int stub: Stub number.
+ * Return value:
+ *** Transaction: The transaction.
+ */
+static Transaction makeTransaction(int stub) {
+    Transaction transaction;
+    memset(&transaction, 0, sizeof(transaction));
+    transaction.stubNumber = stub;
+    transaction.amount = stub * 10;
+    transaction.accountType = stub % 4;
+    transaction.duration = 1 + stub % 7;
+    return transaction;
+}
+
+int main(void) {
+    Transaction batch[MAX_STACK_SIZE + 10];
+    Transaction out[MAX_STACK_SIZE + 10];
+    Stack batched, single;
+
+    for (int i = 0; i < MAX_STACK_SIZE + 10; i++) {
+        batch[i] = makeTransaction(i + 1);
+    }
+
+    // pushBatch leaves the stack as one push per transaction would, last element on top
+    initStack(&batched);
+    initStack(&single);
+    push(&batched, makeTransaction(0));
+    push(&single, makeTransaction(0));
+    check(pushBatch(&batched, batch, 30) == 30, "batch accepted");
+    for (int i = 0; i < 30; i++) {
+        push(&single, batch[i]);
+    }
+    check(batched.top == single.top && memcmp(batched.transactions, single.transactions, (single.top + 1) * sizeof(Transaction)) == 0,
+          "pushBatch matches single pushes");
+
+    // popBatch returns the top elements in stack order, the former top last
+    int count = popBatch(&batched, out, 4);
+    int ok = count == 4;
+    for (int i = 3; i >= 0; i--) {
+        Transaction expected = pop(&single);
+        ok = ok && memcmp(&out[i], &expected, sizeof(Transaction)) == 0;
+    }
+    check(ok, "popBatch matches single pops");
+
+    // Partial acceptance when the stack fills up
+    int room = MAX_STACK_SIZE - 1 - batched.top;
+    check(pushBatch(&batched, batch, MAX_STACK_SIZE + 10) == room && isStackFull(&batched), "pushBatch stops at a full stack");
+    check(pushBatch(&batched, batch, 1) == 0, "full stack accepts nothing");
+
+    // drainStack empties the stack bottom first
+    count = drainStack(&batched, out);
+    check(count == MAX_STACK_SIZE && isStackEmpty(&batched), "drainStack empties the stack");
+    check(out[0].stubNumber == 0 && out[1].stubNumber == 1 && out[MAX_STACK_SIZE - 1].stubNumber == room, "drainStack fills bottom first");
+
+    check(popBatch(&batched, out, 5) == 0 && drainStack(&batched, out) == 0, "empty stack yields nothing");
+    check(pushBatch(&batched, batch, 0) == 0 && isStackEmpty(&batched), "empty batch pushes nothing");
+
+    if (failures > 0) {
+        printf("|-[ ! ]- [ %d checks failed\n", failures);
+        return 1;
+    }
+    printf("|-[ ! ]-[ stack: all checks passed\n");
+    return 0;
+}
@@ -0,0 +1,123 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "../streamstats.h"
+
+#define TEST_RECORDS (2 * STREAM_SPILL_RECORDS + 37)
+
+static int failures = 0;
+
+/**
+ * Function name: check
+ * Description: Report a failed expectation.
+ * Parameters:
+ *** int condition: The expectation, nonzero if it holds.
+ *** const char *message: What was expected.
+ */
+static void check(int condition, const char *message) {
+    if (!condition) {
+        printf("|-[ ! ]- [ FAILED: %s\n", message);
+        failures++;
+    }
+}
+
+/**
+ * Function name: makeRecord
+ * Description: Build the i-th test record. Stub numbers, times and amounts move in both directions
+ *              so the zigzag deltas are exercised with negative values as well.
+ * Parameters:
+ *** int i: Index of the record.
+ * Return value:
+ *** CompletionRecord: The record.
+ */
+static CompletionRecord makeRecord(int i) {
+    CompletionRecord record;
+    memset(&record, 0, sizeof(record));
+    record.transaction.stubNumber = 1 + i + (i % 3 == 0 ? -2 : 5);
+    record.transaction.amount = (i % 7 == 0 ? -1 : 1) * (i * 7919 % 100000);
+    record.transaction.accountType = i % NUM_ACCOUNT_TYPES;
+    record.transaction.duration = 1 + i % 30;
+    record.teller = i % NUM_TELLERS;
+    record.completedAt = i / 2 + (i % 5 == 0 ? 0 : 3);
+    return record;
+}
+
+/**
+ * Function name: sameRecord
+ * Description: Compare the fields a segment stores.
+ * Parameters:
+ *** const CompletionRecord *a: The first record.
+ *** const CompletionRecord *b: The second record.
+ * Return value:
+ *** int: Returns 1 if the records match, otherwise returns 0.
+ */
+static int sameRecord(const CompletionRecord *a, const CompletionRecord *b) {
+    return a->transaction.stubNumber == b->transaction.stubNumber && a->transaction.amount == b->transaction.amount &&
+           a->transaction.accountType == b->transaction.accountType && a->transaction.duration == b->transaction.duration &&
+           a->teller == b->teller && a->completedAt == b->completedAt;
+}
+
+int main(void) {
+    static StreamStats stats;
+    static CompletionRecord records[STREAM_SPILL_RECORDS];
+    char dir[] = "/tmp/streamstats-test-XXXXXX";
+    char path[STREAM_PATH_SIZE + 32];
+
+    if (mkdtemp(dir) == NULL || !initStreamStats(&stats, dir)) {
+        printf("|-[ ! ]- [ Cannot set up %s\n", dir);
+        return 1;
+    }
+
+    // Two full segments are spilled on the way, the rest by the explicit call
+    for (int i = 0; i < TEST_RECORDS; i++) {
+        recordCompletion(&stats, makeRecord(i));
+    }
+    check(stats.segmentCount == 2 && stats.pendingCount == TEST_RECORDS - 2 * STREAM_SPILL_RECORDS, "two segments spilled automatically");
+    check(spillPending(&stats) && stats.segmentCount == 3 && stats.pendingCount == 0, "pending records spilled");
+    check(stats.spilledRecords == TEST_RECORDS && stats.lifetime.total.count == TEST_RECORDS, "every record counted");
+
+    // Every record comes back from the segments in order
+    int next = 0;
+    for (int segment = 0; segment < 3; segment++) {
+        snprintf(path, sizeof(path), "%s/segment-%06d.seg", dir, segment);
+        int count = readSegment(path, records, STREAM_SPILL_RECORDS);
+        check(count > 0, "segment readable");
+        for (int i = 0; i < count; i++, next++) {
+            CompletionRecord expected = makeRecord(next);
+            check(sameRecord(&records[i], &expected), "record round-trips");
+        }
+    }
+    check(next == TEST_RECORDS, "segments hold every record");
+
+    // A truncated segment is reported as corrupt
+    snprintf(path, sizeof(path), "%s/segment-%06d.seg", dir, 0);
+    FILE *file = fopen(path, "r+b");
+    fseek(file, 0, SEEK_END);
+    long length = ftell(file);
+    fclose(file);
+    check(truncate(path, length / 2) == 0 && readSegment(path, records, STREAM_SPILL_RECORDS) == -1, "truncated segment rejected");
+
+    // A second run in the same directory numbers its segments after the existing ones
+    static StreamStats second;
+    check(initStreamStats(&second, dir) && second.firstSegment == 3, "second run continues numbering");
+    recordCompletion(&second, makeRecord(0));
+    check(spillPending(&second), "second run spills");
+    snprintf(path, sizeof(path), "%s/segment-%06d.seg", dir, 3);
+    check(readSegment(path, records, STREAM_SPILL_RECORDS) == 1, "second run wrote segment 3");
+    snprintf(path, sizeof(path), "%s/segment-%06d.seg", dir, 1);
+    check(readSegment(path, records, STREAM_SPILL_RECORDS) == STREAM_SPILL_RECORDS, "earlier segment left intact");
+
+    for (int segment = 0; segment < 4; segment++) {
+        snprintf(path, sizeof(path), "%s/segment-%06d.seg", dir, segment);
+        remove(path);
+    }
+    remove(dir);
+
+    if (failures > 0) {
+        printf("|-[ ! ]- [ %d checks failed\n", failures);
+        return 1;
+    }
+    printf("|-[ ! ]-[ streamstats: all checks passed\n");
+    return 0;
+}
@@ -0,0 +1,138 @@
+#include <stdio.h>
+#include <string.h>
+#include "../tellerkernel.h"
+
+#define TEST_MAX_TELLERS 1031
+#define TEST_ROUNDS 40
+
+static int failures = 0;
+static unsigned long long randomState = 0x9E3779B97F4A7C15ULL;
+
+/**
+ * Function name: check
+ * Description: Report a failed expectation.
+ * Parameters:
+ *** int condition: The expectation, nonzero if it holds.
+ *** const char *message: What was expected.
+ *** int count: Number of tellers the kernel ran on.
+ */
+static void check(int condition, const char *message, int count) {
+    if (!condition) {
+        printf("|-[ ! ]- [ FAILED: %s with %d tellers\n", message, count);
+        failures++;
+    }
+}
+
+/**
+ * Function name: nextRandom
+ * Description: Draw a number from a SplitMix64 generator, so every run tests the same states.
+ * Parameters:
+ *** int range: Upper bound, exclusive.
+ * Return value:
+ *** int: A number from 0 to range - 1.
+ */
+static int nextRandom(int range) {
+    unsigned long long z = (randomState += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return (int)((z ^ (z >> 31)) % (unsigned long long)range);
+}
+
+/**
+ * Function name: referenceUpdate
+ * Description: Plain loop with the behavior updateTellers must match on every code path.
+ * Parameters:
+ *** int *remainingTime, int *isBusy, int *busyTime, int count, unsigned int *completedMask: As for updateTellers.
+ * Return value:
+ *** int: The number of tellers that completed their transaction.
+ */
+static int referenceUpdate(int *remainingTime, int *isBusy, int *busyTime, int count, unsigned int *completedMask) {
+    int completed = 0;
+    memset(completedMask, 0, TELLER_MASK_WORDS(count) * sizeof(unsigned int));
+    for (int i = 0; i < count; i++) {
+        if (isBusy[i]) {
+            remainingTime[i]--;
+            busyTime[i]++;
+            if (remainingTime[i] == 0) {
+                isBusy[i] = 0;
+                completedMask[i / TELLER_MASK_BITS] |= 1u << (i % TELLER_MASK_BITS);
+                completed++;
+            }
+        }
+    }
+    return completed;
+}
+
+/**
+ * Function name: testCount
+ * Description: Run the kernel and the reference side by side for several minutes on random tellers.
+ * Parameters:
+ *** int count: Number of tellers.
+ */
+static void testCount(int count) {
+    static int remaining[2][TEST_MAX_TELLERS], busy[2][TEST_MAX_TELLERS], time[2][TEST_MAX_TELLERS];
+    static unsigned int mask[2][TELLER_MASK_WORDS(TEST_MAX_TELLERS) + 1];
+    int words = TELLER_MASK_WORDS(count);
+
+    for (int i = 0; i < count; i++) {
+        busy[0][i] = nextRandom(3) != 0;
+        remaining[0][i] = busy[0][i] ? 1 + nextRandom(4) : 0;
+        time[0][i] = nextRandom(1000);
+    }
+    memcpy(remaining[1], remaining[0], sizeof(remaining[0]));
+    memcpy(busy[1], busy[0], sizeof(busy[0]));
+    memcpy(time[1], time[0], sizeof(time[0]));
+
+    for (int round = 0; round < TEST_ROUNDS; round++) {
+        // The word after the mask must not be touched
+        mask[0][words] = mask[1][words] = 0xA5A5A5A5u;
+        int expected = referenceUpdate(remaining[0], busy[0], time[0], count, mask[0]);
+        int actual = updateTellers(remaining[1], busy[1], time[1], count, mask[1]);
+
+        check(actual == expected, "completed count", count);
+        check(memcmp(remaining[0], remaining[1], count * sizeof(int)) == 0, "remaining times", count);
+        check(memcmp(busy[0], busy[1], count * sizeof(int)) == 0, "busy flags", count);
+        check(memcmp(time[0], time[1], count * sizeof(int)) == 0, "busy times", count);
+        check(memcmp(mask[0], mask[1], (words + 1) * sizeof(unsigned int)) == 0, "completion mask", count);
+
+        // The completed tellers come out of the mask in ascending order, once each
+        int previous = -1;
+        int taken = 0;
+        int teller;
+        while ((teller = nextCompletedTeller(mask[1], words)) >= 0) {
+            check(teller > previous && teller < count && busy[1][teller] == 0, "completed teller order", count);
+            previous = teller;
+            taken++;
+        }
+        check(taken == expected, "completed tellers taken", count);
+
+        // Idle tellers pick up a new transaction, as tickBank would
+        for (int i = 0; i < count; i++) {
+            if (!busy[0][i] && nextRandom(2)) {
+                busy[0][i] = busy[1][i] = 1;
+                remaining[0][i] = remaining[1][i] = 1 + nextRandom(4);
+            }
+        }
+    }
+}
+
+int main(void) {
+    // Every remainder of the 4 and 8 wide loops, the 5 tellers of the bank, and mask word boundaries
+    static const int counts[] = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 12, 15, 16, 17, 31, 32, 33, 63, 64, 65, 100, 257, 1024, 1031 };
+    for (int c = 0; c < (int)(sizeof(counts) / sizeof(counts[0])); c++) {
+        testCount(counts[c]);
+    }
+
+    if (failures > 0) {
+        printf("|-[ ! ]- [ %d checks failed\n", failures);
+        return 1;
+    }
+#if defined(__AVX2__)
+    printf("|-[ ! ]-[ tellerkernel (AVX2): all checks passed\n");
+#elif defined(__SSE2__)
+    printf("|-[ ! ]-[ tellerkernel (SSE2): all checks passed\n");
+#else
+    printf("|-[ ! ]-[ tellerkernel (scalar): all checks passed\n");
+#endif
+    return 0;
+}
@@ -0,0 +1,186 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../timerwheel.h"
+
+#define TEST_TIMERS 20000
+#define TEST_STEPS 6000
+#define TEST_SPAN (1 << (WHEEL_LEVELS * WHEEL_SLOT_BITS))
+
+// Define a timer as the reference sees it
+typedef struct {
+    int handle;
+    int addedAt; // Tick the wheel was at when the timer was armed
+    int dueAt;   // Tick at which the timer must fire
+    int armed;
+    int firedAt; // Tick at which it fired, -1 until then
+} ReferenceTimer;
+
+static int failures = 0;
+static unsigned long long randomState = 0xD1B54A32D192ED03ULL;
+static ReferenceTimer timers[TEST_TIMERS];
+static int timerCount = 0;
+
+/**
+ * Function name: check
+ * Description: Report a failed expectation.
+ * Parameters:
+ *** int condition: The expectation, nonzero if it holds.
+ *** const char *message: What was expected.
+ */
+static void check(int condition, const char *message) {
+    if (!condition) {
+        printf("|-[ ! ]- [ FAILED: %s\n", message);
+        failures++;
+    }
+}
+
+/**
+ * Function name: nextRandom
+ * Description: Draw a number from a SplitMix64 generator, so every run tests the same schedule.
+ * Parameters:
+ *** int range: Upper bound, exclusive.
+ * Return value:
+ *** int: A number from 0 to range - 1.
+ */
+static int nextRandom(int range) {
+    unsigned long long z = (randomState += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return (int)((z ^ (z >> 31)) % (unsigned long long)range);
+}
+
+/**
+ * Function name: onExpire
+ * Description: Record the tick at which a timer fired.
+ * Parameters:
+ *** void *context: The timing wheel.
+ *** int payload: Index of the timer in the reference.
+ */
+static void onExpire(void *context, int payload) {
+    TimerWheel *wheel = (TimerWheel *)context;
+    check(payload >= 0 && payload < timerCount && timers[payload].firedAt == -1, "timer fires once");
+    if (payload >= 0 && payload < timerCount) {
+        timers[payload].firedAt = wheel->now;
+    }
+}
+
+/**
+ * Function name: randomDelay
+ * Description: Pick how far from now a new timer expires, covering every level of the wheel,
+ *              the parking of timers beyond its span and timers that are already due.
+ * Return value:
+ *** int: The delay in ticks, possibly negative.
+ */
+static int randomDelay(void) {
+    switch (nextRandom(10)) {
+        case 0:
+            return -nextRandom(5);
+        case 1:
+            return TEST_SPAN - 50 + nextRandom(3 * WHEEL_SLOTS * WHEEL_SLOTS);
+        case 2:
+            return WHEEL_SLOTS * WHEEL_SLOTS * WHEEL_SLOTS + nextRandom(TEST_SPAN / 4);
+        case 3:
+        case 4:
+            return WHEEL_SLOTS + nextRandom(WHEEL_SLOTS * WHEEL_SLOTS * 2);
+        default:
+            return nextRandom(2 * WHEEL_SLOTS);
+    }
+}
+
+int main(void) {
+    static TimerWheel wheel, copy;
+    int start = 1000 + nextRandom(100000);
+
+    check(initTimerWheel(&wheel, start), "wheel initialized");
+    check(cancelTimer(&wheel, -1) == 0 && cancelTimer(&wheel, 0) == 0 && cancelTimer(&wheel, WHEEL_SENTINELS) == 0,
+          "no handle cancels anything in an empty wheel");
+
+    for (int step = 0; step < TEST_STEPS; step++) {
+        int now = wheel.now;
+
+        // Arm a few timers, they fire once the wheel reaches their tick but never at the current one
+        for (int n = nextRandom(5); n > 0 && timerCount < TEST_TIMERS; n--) {
+            ReferenceTimer *timer = &timers[timerCount];
+            int expires = now + randomDelay();
+            timer->handle = addTimer(&wheel, expires, timerCount);
+            timer->addedAt = now;
+            timer->dueAt = expires > now ? expires : now + 1;
+            timer->armed = 1;
+            timer->firedAt = -1;
+            check(timer->handle >= 0, "timer armed");
+            timerCount++;
+        }
+
+        // Cancel armed timers, and try handles of timers that fired or were cancelled already
+        for (int n = nextRandom(3); n > 0 && timerCount > 0; n--) {
+            ReferenceTimer *timer = &timers[nextRandom(timerCount)];
+            int live = timer->armed && timer->firedAt == -1;
+            int count = wheel.count;
+            check(cancelTimer(&wheel, timer->handle) == live, live ? "armed timer cancelled" : "stale handle refused");
+            check(wheel.count == count - live, "count follows cancels");
+            timer->armed = timer->armed && !live;
+        }
+
+        // Mostly short advances, sometimes far enough to cascade from the coarse levels or reach parked timers
+        int target = now + 1 + nextRandom(4);
+        if (nextRandom(50) == 0) {
+            target = now + nextRandom(TEST_SPAN / 8);
+        } else if (nextRandom(20) == 0) {
+            target = now + nextRandom(WHEEL_SLOTS * WHEEL_SLOTS * 4);
+        }
+        int expected = 0;
+        for (int i = 0; i < timerCount; i++) {
+            expected += timers[i].armed && timers[i].firedAt == -1 && timers[i].dueAt <= target;
+        }
+        check(advanceTimerWheel(&wheel, target, onExpire, &wheel) == expected, "fired count matches the reference");
+
+        // A copy keeps the same handles and schedule
+        if (step % 1000 == 999) {
+            check(copyTimerWheel(&copy, &wheel) && copy.count == wheel.count && copy.now == wheel.now, "wheel copied");
+        }
+    }
+
+    // Every armed timer fires at its own tick, and the pool goes back to empty
+    advanceTimerWheel(&wheel, wheel.now + 2 * TEST_SPAN, onExpire, &wheel);
+    int exact = 1;
+    int cascaded = 0;
+    int parked = 0;
+    for (int i = 0; i < timerCount; i++) {
+        if (timers[i].armed) {
+            exact = exact && timers[i].firedAt == timers[i].dueAt;
+            cascaded += timers[i].dueAt - timers[i].addedAt >= WHEEL_SLOTS * WHEEL_SLOTS;
+            parked += timers[i].dueAt - timers[i].addedAt >= TEST_SPAN;
+        } else {
+            exact = exact && timers[i].firedAt == -1;
+        }
+    }
+    check(exact, "armed timers fire exactly at their tick, cancelled ones never");
+    check(wheel.count == 0, "no timer left armed");
+    check(cascaded > 0 && parked > 0, "schedule reached the cascade and the parked timers");
+
+    // Handles kept from a timer that fired do not cancel the timer that reuses its node
+    int first = addTimer(&wheel, wheel.now + 5, 0);
+    timers[0].firedAt = -1;
+    advanceTimerWheel(&wheel, wheel.now + 5, onExpire, &wheel);
+    int second = addTimer(&wheel, wheel.now + 5, 0);
+    check((first & (WHEEL_MAX_NODES - 1)) == (second & (WHEEL_MAX_NODES - 1)) && first != second, "node reused under a new handle");
+    check(cancelTimer(&wheel, first) == 0 && wheel.count == 1, "handle of the fired timer refused");
+    check(cancelTimer(&wheel, second) == 1 && cancelTimer(&wheel, second) == 0 && wheel.count == 0, "double cancel refused");
+
+    // The copy still holds the timers armed at the time, and they fire from the copy alone
+    int pending = copy.count;
+    for (int i = 0; i < timerCount; i++) {
+        timers[i].firedAt = -1;
+    }
+    check(advanceTimerWheel(&copy, copy.now + 2 * TEST_SPAN, onExpire, &copy) == pending, "copy fires its own timers");
+
+    freeTimerWheel(&wheel);
+    freeTimerWheel(&copy);
+    if (failures > 0) {
+        printf("|-[ ! ]- [ %d checks failed\n", failures);
+        return 1;
+    }
+    printf("|-[ ! ]-[ timerwheel: all checks passed\n");
+    return 0;
+}
@@ -0,0 +1,187 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "../trace.h"
+
+#define TEST_EVENTS (2 * TRACE_BLOCK_EVENTS + 100)
+#define TEST_EXIT_GAP 7
+
+static int failures = 0;
+static unsigned long long randomState = 0x2545F4914F6CDD1DULL;
+
+/**
+ * Function name: check
+ * Description: Report a failed expectation.
+ * Parameters:
+ *** int condition: The expectation, nonzero if it holds.
+ *** const char *message: What was expected.
+ */
+static void check(int condition, const char *message) {
+    if (!condition) {
+        printf("|-[ ! ]- [ FAILED: %s\n", message);
+        failures++;
+    }
+}
+
+/**
+ * Function name: nextRandom
+ * Description: Draw a number from a SplitMix64 generator, so every run writes the same trace.
+ * Parameters:
+ *** int range: Upper bound, exclusive.
+ * Return value:
+ *** int: A number from 0 to range - 1.
+ */
+static int nextRandom(int range) {
+    unsigned long long z = (randomState += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return (int)((z ^ (z >> 31)) % (unsigned long long)range);
+}
+
+/**
+ * Function name: writeTrace
+ * Description: Write events to a trace file, exiting a few idle minutes after the last one.
+ * Parameters:
+ *** const char *path: Path of the trace.
+ *** const TraceEvent *events: The events, in minute order.
+ *** int count: Number of events.
+ * Return value:
+ *** int: Returns 1 if the trace was written, otherwise returns 0.
+ */
+static int writeTrace(const char *path, const TraceEvent *events, int count) {
+    static TraceWriter writer;
+    int ok = openTraceWriter(&writer, path);
+    for (int i = 0; ok && i < count; i++) {
+        ok = writeTraceEvent(&writer, &events[i]);
+    }
+    return closeTraceWriter(&writer, count > 0 ? events[count - 1].minute + TEST_EXIT_GAP : 0) && ok;
+}
+
+/**
+ * Function name: replayMatches
+ * Description: Replay a trace from the current reader position and compare every minute with the events.
+ * Parameters:
+ *** TraceReader *reader: Pointer to the trace reader.
+ *** const TraceEvent *events: The events that were written.
+ *** int count: Number of events.
+ *** int minute: Minute the reader is positioned at.
+ * Return value:
+ *** int: Returns 1 if every minute up to the exit matches, otherwise returns 0.
+ */
+static int replayMatches(TraceReader *reader, const TraceEvent *events, int count, int minute) {
+    int exitMinute = events[count - 1].minute + TEST_EXIT_GAP;
+    int next = 0;
+    TraceEvent event;
+
+    while (next < count && events[next].minute < minute) {
+        next++;
+    }
+    for (; minute <= exitMinute; minute++) {
+        if (!nextTraceEvent(reader, &event) || event.minute != minute) {
+            return 0;
+        }
+        if (minute == exitMinute) {
+            return event.type == TRACE_EXIT;
+        }
+        if (next < count && events[next].minute == minute) {
+            if (memcmp(&event, &events[next], sizeof(TraceEvent)) != 0) {
+                return 0;
+            }
+            next++;
+        } else if (event.type != TRACE_IDLE) {
+            return 0;
+        }
+    }
+    return 0;
+}
+
+/**
+ * Function name: patchByte
+ * Description: Overwrite one byte of a file.
+ * Parameters:
+ *** const char *path: Path of the file.
+ *** long offset: Offset of the byte.
+ *** int value: The new value.
+ */
+static void patchByte(const char *path, long offset, int value) {
+    FILE *file = fopen(path, "r+b");
+    fseek(file, offset, SEEK_SET);
+    fputc(value, file);
+    fclose(file);
+}
+
+int main(void) {
+    static TraceEvent events[TEST_EVENTS];
+    static TraceReader reader;
+    char path[] = "/tmp/trace-test-XXXXXX";
+    int fd = mkstemp(path);
+    if (fd < 0) {
+        printf("|-[ ! ]- [ Cannot create %s\n", path);
+        return 1;
+    }
+    close(fd);
+
+    // Three blocks, with idle gaps of up to a few hundred minutes and some reports
+    int minute = nextRandom(3);
+    for (int i = 0; i < TEST_EVENTS; i++) {
+        TraceEvent *event = &events[i];
+        memset(event, 0, sizeof(*event));
+        event->minute = minute;
+        event->type = nextRandom(10) == 0 ? TRACE_REPORT : TRACE_ARRIVAL;
+        if (event->type == TRACE_ARRIVAL) {
+            event->amount = nextRandom(200001) - 100000;
+            event->accountType = nextRandom(4);
+        }
+        minute += 1 + (nextRandom(20) == 0 ? nextRandom(300) : nextRandom(3));
+    }
+    check(writeTrace(path, events, TEST_EVENTS), "trace written");
+    check(openTraceReader(&reader, path) && reader.blockCount == 3, "trace split into three blocks");
+    check(replayMatches(&reader, events, TEST_EVENTS, 0), "every minute replays across block boundaries");
+
+    // Seeking lands on the right minute inside a block, at a block start, in a gap and past the exit
+    int last = events[TEST_EVENTS - 1].minute;
+    int targets[] = { 0, events[1].minute, events[TRACE_BLOCK_EVENTS].minute, events[TRACE_BLOCK_EVENTS].minute - 1,
+                      events[TRACE_BLOCK_EVENTS + 17].minute + 1, events[2 * TRACE_BLOCK_EVENTS + 50].minute, last, last + 1 };
+    for (int t = 0; t < (int)(sizeof(targets) / sizeof(targets[0])); t++) {
+        check(seekTrace(&reader, targets[t]) && replayMatches(&reader, events, TEST_EVENTS, targets[t]), "replay after seekTrace");
+    }
+    long secondBlock = (long)reader.index[1].offset;
+    closeTraceReader(&reader);
+
+    // A changed payload byte in the second block fails its checksum once the replay reaches it
+    TraceEvent event;
+    patchByte(path, secondBlock + 20 + 100, 0xFF);
+    check(openTraceReader(&reader, path) && seekTrace(&reader, 0), "first block still readable");
+    check(!seekTrace(&reader, events[TRACE_BLOCK_EVENTS].minute), "checksum mismatch found by seekTrace");
+    seekTrace(&reader, 0);
+    int ok = 1;
+    for (int i = 0; i <= events[TRACE_BLOCK_EVENTS].minute && ok; i++) {
+        ok = nextTraceEvent(&reader, &event);
+    }
+    check(!ok && event.type == TRACE_EXIT, "checksum mismatch ends the replay");
+    closeTraceReader(&reader);
+
+    // A header counting more arrivals than the payload holds is rejected, even though the payload decodes
+    for (int i = 0; i < 6; i++) {
+        memset(&events[i], 0, sizeof(TraceEvent));
+        events[i].minute = 2 * i;
+        events[i].type = i == 3 ? TRACE_REPORT : TRACE_ARRIVAL;
+        events[i].amount = i == 3 ? 0 : 10 * i;
+        events[i].accountType = i == 3 ? 0 : i % 4;
+    }
+    check(writeTrace(path, events, 6), "short trace written");
+    check(openTraceReader(&reader, path) && replayMatches(&reader, events, 6, 0), "short trace replays");
+    closeTraceReader(&reader);
+    patchByte(path, 5 + 4, 6); // Arrival count of the first block, 5 arrivals need the same 2 type bytes as 6
+    check(openTraceReader(&reader, path) && !seekTrace(&reader, 0), "arrival count mismatch rejected");
+    closeTraceReader(&reader);
+
+    remove(path);
+    if (failures > 0) {
+        printf("|-[ ! ]- [ %d checks failed\n", failures);
+        return 1;
+    }
+    printf("|-[ ! ]-[ trace: all checks passed\n");
+    return 0;
+}
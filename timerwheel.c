@@ -0,0 +1,266 @@
+#include "timerwheel.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define WHEEL_SPAN (1 << (WHEEL_LEVELS * WHEEL_SLOT_BITS))
+
+/**
+ * Function name: linkTail
+ * Description: Append a node to the end of a slot list.
+ * Parameters:
+ *** TimerWheel *wheel: Pointer to the timing wheel.
+ *** int sentinel: Index of the slot sentinel.
+ *** int node: Index of the node to append.
+ */
+static void linkTail(TimerWheel *wheel, int sentinel, int node) {
+    TimerNode *nodes = wheel->nodes;
+    nodes[node].next = sentinel;
+    nodes[node].prev = nodes[sentinel].prev;
+    nodes[nodes[sentinel].prev].next = node;
+    nodes[sentinel].prev = node;
+}
+
+/**
+ * Function name: unlinkNode
+ * Description: Remove a node from whatever slot list it is in.
+ * Parameters:
+ *** TimerWheel *wheel: Pointer to the timing wheel.
+ *** int node: Index of the node to remove.
+ */
+static void unlinkNode(TimerWheel *wheel, int node) {
+    TimerNode *nodes = wheel->nodes;
+    nodes[nodes[node].prev].next = nodes[node].next;
+    nodes[nodes[node].next].prev = nodes[node].prev;
+}
+
+/**
+ * Function name: releaseNode
+ * Description: Return a timer to the free list. Its generation moves on, so earlier handles stop matching.
+ * Parameters:
+ *** TimerWheel *wheel: Pointer to the timing wheel.
+ *** int node: Index of the timer, already unlinked from its slot list.
+ */
+static void releaseNode(TimerWheel *wheel, int node) {
+    wheel->nodes[node].prev = -1;
+    wheel->nodes[node].generation = (wheel->nodes[node].generation + 1) & WHEEL_GENERATION_MASK;
+    wheel->nodes[node].next = wheel->freeList;
+    wheel->freeList = node;
+    wheel->count--;
+}
+
+/**
+ * Function name: placeNode
+ * Description: Put a timer in the slot matching its distance from the current tick. Near timers
+ *              go to level 0 with one slot per tick, farther ones to coarser levels.
+ * Parameters:
+ *** TimerWheel *wheel: Pointer to the timing wheel.
+ *** int node: Index of the timer.
+ *** int earliest: First tick whose level 0 slot has not been run yet.
+ */
+static void placeNode(TimerWheel *wheel, int node, int earliest) {
+    int target = wheel->nodes[node].expires;
+    if (target < earliest) {
+        target = earliest; // Already due, fire as soon as possible
+    } else if (target - wheel->now >= WHEEL_SPAN) {
+        target = wheel->now + WHEEL_SPAN - 1; // Too far, park it and re-place it when it comes around
+    }
+
+    int delta = target - wheel->now;
+    int level = 0;
+    while (level < WHEEL_LEVELS - 1 && (delta >> ((level + 1) * WHEEL_SLOT_BITS)) != 0) {
+        level++;
+    }
+    int slot = (target >> (level * WHEEL_SLOT_BITS)) & (WHEEL_SLOTS - 1);
+    linkTail(wheel, level * WHEEL_SLOTS + slot, node);
+}
+
+/**
+ * Function name: growPool
+ * Description: Double the timer pool and add the new timers to the free list.
+ * Parameters:
+ *** TimerWheel *wheel: Pointer to the timing wheel.
+ * Return value:
+ *** int: Returns 1 on success, otherwise returns 0.
+ */
+static int growPool(TimerWheel *wheel) {
+    int capacity = wheel->capacity * 2;
+    if (capacity > WHEEL_MAX_NODES) {
+        capacity = WHEEL_MAX_NODES;
+    }
+    if (capacity == wheel->capacity) {
+        return 0; // Handles have no room for more node indices
+    }
+    TimerNode *nodes = (TimerNode *)realloc(wheel->nodes, capacity * sizeof(TimerNode));
+    if (nodes == NULL) {
+        return 0;
+    }
+    for (int i = wheel->capacity; i < capacity; i++) {
+        nodes[i].next = i + 1 < capacity ? i + 1 : wheel->freeList;
+        nodes[i].prev = -1;
+        nodes[i].generation = 0;
+    }
+    wheel->freeList = wheel->capacity;
+    wheel->nodes = nodes;
+    wheel->capacity = capacity;
+    return 1;
+}
+
+/**
+ * Function name: initTimerWheel
+ * Description: Initialize an empty timing wheel.
+ * Parameters:
+ *** TimerWheel *wheel: Pointer to the timing wheel to be initialized.
+ *** int now: The current tick.
+ * Return value:
+ *** int: Returns 1 on success, otherwise returns 0.
+ */
+int initTimerWheel(TimerWheel *wheel, int now) {
+    wheel->capacity = WHEEL_SENTINELS + WHEEL_INITIAL_TIMERS;
+    wheel->nodes = (TimerNode *)malloc(wheel->capacity * sizeof(TimerNode));
+    if (wheel->nodes == NULL) {
+        return 0;
+    }
+    for (int i = 0; i < WHEEL_SENTINELS; i++) {
+        wheel->nodes[i].next = i;
+        wheel->nodes[i].prev = i;
+    }
+    for (int i = WHEEL_SENTINELS; i < wheel->capacity; i++) {
+        wheel->nodes[i].next = i + 1 < wheel->capacity ? i + 1 : -1;
+        wheel->nodes[i].prev = -1;
+        wheel->nodes[i].generation = 0;
+    }
+    wheel->freeList = WHEEL_SENTINELS;
+    wheel->now = now;
+    wheel->count = 0;
+    return 1;
+}
+
+/**
+ * Function name: freeTimerWheel
+ * Description: Release the memory of a timing wheel.
+ * Parameters:
+ *** TimerWheel *wheel: Pointer to the timing wheel.
+ */
+void freeTimerWheel(TimerWheel *wheel) {
+    free(wheel->nodes);
+    wheel->nodes = NULL;
+    wheel->capacity = 0;
+    wheel->count = 0;
+}
+
+/**
+ * Function name: copyTimerWheel
+ * Description: Make an independent copy of a timing wheel. Handles stay valid in the copy.
+ * Parameters:
+ *** TimerWheel *copy: Pointer to the destination, its previous nodes are released.
+ *** const TimerWheel *wheel: Pointer to the timing wheel to copy.
+ * Return value:
+ *** int: Returns 1 on success, otherwise returns 0.
+ */
+int copyTimerWheel(TimerWheel *copy, const TimerWheel *wheel) {
+    TimerNode *nodes = NULL;
+    if (wheel->nodes != NULL) {
+        nodes = (TimerNode *)malloc(wheel->capacity * sizeof(TimerNode));
+        if (nodes == NULL) {
+            return 0;
+        }
+        memcpy(nodes, wheel->nodes, wheel->capacity * sizeof(TimerNode)); // Nodes link by index, not by pointer
+    }
+    free(copy->nodes);
+    *copy = *wheel;
+    copy->nodes = nodes;
+    return 1;
+}
+
+/**
+ * Function name: addTimer
+ * Description: Arm a timer that fires once the wheel reaches the given tick.
+ * Parameters:
+ *** TimerWheel *wheel: Pointer to the timing wheel.
+ *** int expires: Tick at which the timer fires.
+ *** int payload: Value handed to the expiry callback.
+ * Return value:
+ *** int: A handle for cancelTimer, or -1 if memory ran out or WHEEL_MAX_NODES timers are armed.
+ */
+int addTimer(TimerWheel *wheel, int expires, int payload) {
+    if (wheel->freeList == -1 && !growPool(wheel)) {
+        return -1;
+    }
+    int node = wheel->freeList;
+    wheel->freeList = wheel->nodes[node].next;
+    wheel->nodes[node].expires = expires;
+    wheel->nodes[node].payload = payload;
+    placeNode(wheel, node, wheel->now + 1);
+    wheel->count++;
+    return wheel->nodes[node].generation << WHEEL_INDEX_BITS | node;
+}
+
+/**
+ * Function name: cancelTimer
+ * Description: Disarm a timer that has not fired yet. A handle whose timer already fired or was
+ *              cancelled is ignored, even when its node has been reused by a later timer.
+ * Parameters:
+ *** TimerWheel *wheel: Pointer to the timing wheel.
+ *** int handle: Handle returned by addTimer, or -1.
+ * Return value:
+ *** int: Returns 1 if the timer was disarmed, or 0 if the handle does not belong to an armed timer.
+ */
+int cancelTimer(TimerWheel *wheel, int handle) {
+    if (handle < 0) {
+        return 0;
+    }
+    int node = handle & (WHEEL_MAX_NODES - 1);
+    if (node < WHEEL_SENTINELS || node >= wheel->capacity || wheel->nodes[node].prev == -1 ||
+        wheel->nodes[node].generation != handle >> WHEEL_INDEX_BITS) {
+        return 0;
+    }
+    unlinkNode(wheel, node);
+    releaseNode(wheel, node);
+    return 1;
+}
+
+/**
+ * Function name: advanceTimerWheel
+ * Description: Move the wheel forward tick by tick up to the given tick, firing every timer that expires.
+ *              When a level completes a turn, the next coarser slot is spread over the finer levels.
+ * Parameters:
+ *** TimerWheel *wheel: Pointer to the timing wheel.
+ *** int until: Tick to advance to.
+ *** void (*onExpire)(void *, int): Callback run with the payload of each expired timer.
+ *** void *context: Value passed to the callback.
+ * Return value:
+ *** int: The number of timers that fired.
+ */
+int advanceTimerWheel(TimerWheel *wheel, int until, void (*onExpire)(void *context, int payload), void *context) {
+    int fired = 0;
+    while (wheel->now < until) {
+        wheel->now++;
+
+        for (int level = WHEEL_LEVELS - 1; level > 0; level--) {
+            if ((wheel->now & ((1 << (level * WHEEL_SLOT_BITS)) - 1)) != 0) {
+                continue;
+            }
+            int sentinel = level * WHEEL_SLOTS + ((wheel->now >> (level * WHEEL_SLOT_BITS)) & (WHEEL_SLOTS - 1));
+            while (wheel->nodes[sentinel].next != sentinel) {
+                int node = wheel->nodes[sentinel].next;
+                unlinkNode(wheel, node);
+                placeNode(wheel, node, wheel->now); // The level 0 slot of this tick is run below
+            }
+        }
+
+        int sentinel = wheel->now & (WHEEL_SLOTS - 1);
+        while (wheel->nodes[sentinel].next != sentinel) {
+            int node = wheel->nodes[sentinel].next;
+            unlinkNode(wheel, node);
+            if (wheel->nodes[node].expires > wheel->now) {
+                placeNode(wheel, node, wheel->now + 1); // A parked far timer, not due yet
+                continue;
+            }
+            int payload = wheel->nodes[node].payload;
+            releaseNode(wheel, node);
+            fired++;
+            onExpire(context, payload);
+        }
+    }
+    return fired;
+}
@@ -0,0 +1,43 @@
+#ifndef TIMERWHEEL_H
+#define TIMERWHEEL_H
+
+// Define the wheel geometry: 4 levels of 64 slots cover 64^4 ticks
+#define WHEEL_LEVELS 4
+#define WHEEL_SLOT_BITS 6
+#define WHEEL_SLOTS (1 << WHEEL_SLOT_BITS)
+#define WHEEL_SENTINELS (WHEEL_LEVELS * WHEEL_SLOTS)
+#define WHEEL_INITIAL_TIMERS 1024
+
+// A handle holds the node index in its low bits and the node generation above them,
+// so a handle stops matching once its timer has fired or was cancelled
+#define WHEEL_INDEX_BITS 20
+#define WHEEL_MAX_NODES (1 << WHEEL_INDEX_BITS)
+#define WHEEL_GENERATION_MASK ((1 << (31 - WHEEL_INDEX_BITS)) - 1)
+
+// A timer, or the sentinel of a slot list when its index is below WHEEL_SENTINELS
+typedef struct {
+    int next;
+    int prev;         // -1 while the timer is unused
+    int expires;
+    int payload;
+    int generation;   // Advanced every time the timer is released
+} TimerNode;
+
+// Define a hierarchical timing wheel with O(1) insert and cancel
+typedef struct {
+    TimerNode *nodes; // Slot sentinels first, then the timer pool
+    int capacity;
+    int freeList;     // First unused timer, linked through next
+    int now;          // Last tick the wheel was advanced to
+    int count;        // Number of armed timers
+} TimerWheel;
+
+// Function declarations
+int initTimerWheel(TimerWheel *wheel, int now);
+void freeTimerWheel(TimerWheel *wheel);
+int copyTimerWheel(TimerWheel *copy, const TimerWheel *wheel);
+int addTimer(TimerWheel *wheel, int expires, int payload);
+int cancelTimer(TimerWheel *wheel, int handle);
+int advanceTimerWheel(TimerWheel *wheel, int until, void (*onExpire)(void *context, int payload), void *context);
+
+#endif // TIMERWHEEL_H
@@ -0,0 +1,420 @@
+#include "trace.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define TRACE_MAGIC "CCTR"
+#define TRACE_FOOTER_MAGIC "CCTE"
+#define TRACE_VERSION 1
+#define TRACE_BLOCK_HEADER 20
+#define TRACE_INDEX_ENTRY 12
+#define TRACE_FOOTER 16
+
+/**
+ * Function name: putLittleEndian
+ * Description: Write an unsigned integer as little-endian bytes.
+ * Parameters:
+ *** unsigned char *buffer: Destination buffer.
+ *** unsigned long long value: The value to write.
+ *** int bytes: Number of bytes to write.
+ */
+static void putLittleEndian(unsigned char *buffer, unsigned long long value, int bytes) {
+    for (int i = 0; i < bytes; i++) {
+        buffer[i] = (unsigned char)(value >> (8 * i));
+    }
+}
+
+/**
+ * Function name: getLittleEndian
+ * Description: Read an unsigned integer stored as little-endian bytes.
+ * Parameters:
+ *** const unsigned char *buffer: Source buffer.
+ *** int bytes: Number of bytes to read.
+ * Return value:
+ *** unsigned long long: The value.
+ */
+static unsigned long long getLittleEndian(const unsigned char *buffer, int bytes) {
+    unsigned long long value = 0;
+    for (int i = 0; i < bytes; i++) {
+        value |= (unsigned long long)buffer[i] << (8 * i);
+    }
+    return value;
+}
+
+/**
+ * Function name: writeBlock
+ * Description: Encode the buffered events as one block and append it to the trace.
+ * Parameters:
+ *** TraceWriter *writer: Pointer to the trace writer.
+ * Return value:
+ *** int: Returns 1 on success, otherwise returns 0.
+ */
+static int writeBlock(TraceWriter *writer) {
+    unsigned char header[TRACE_BLOCK_HEADER];
+    int arrivals = 0;
+    int length;
+
+    if (writer->eventCount == 0) {
+        return 1;
+    }
+
+    if (writer->blockCount == writer->indexCapacity) {
+        int capacity = writer->indexCapacity > 0 ? writer->indexCapacity * 2 : 64;
+        TraceBlock *index = realloc(writer->index, capacity * sizeof(TraceBlock));
+        if (index == NULL) {
+            printf("|-[ ! ]- [ Out of memory for the trace index\n");
+            return 0;
+        }
+        writer->index = index;
+        writer->indexCapacity = capacity;
+    }
+
+    for (int i = 0; i < writer->eventCount; i++) {
+        arrivals += writer->events[i].type == TRACE_ARRIVAL;
+    }
+
+    // Account types first, packed four to a byte
+    length = (arrivals + 3) / 4;
+    memset(writer->payload, 0, length);
+    int startMinute = writer->events[0].minute;
+    int previous = startMinute;
+    arrivals = 0;
+    for (int i = 0; i < writer->eventCount; i++) {
+        const TraceEvent *event = &writer->events[i];
+        if (event->type == TRACE_ARRIVAL) {
+            writer->payload[arrivals / 4] |= (unsigned char)((event->accountType & 0x3) << (2 * (arrivals % 4)));
+            arrivals++;
+        }
+    }
+
+    // Then the minutes and amounts
+    for (int i = 0; i < writer->eventCount; i++) {
+        const TraceEvent *event = &writer->events[i];
+        unsigned long long gap = (unsigned long long)(event->minute - previous);
+        length += putVarint(writer->payload + length, gap << 1 | (event->type == TRACE_REPORT));
+        if (event->type == TRACE_ARRIVAL) {
+            length += putVarint(writer->payload + length, zigzagEncode(event->amount));
+        }
+        previous = event->minute + 1;
+    }
+
+    writer->index[writer->blockCount].startMinute = startMinute;
+    writer->index[writer->blockCount].offset = ftell(writer->file);
+    writer->blockCount++;
+
+    putLittleEndian(header, (unsigned long long)writer->eventCount, 4);
+    putLittleEndian(header + 4, (unsigned long long)arrivals, 4);
+    putLittleEndian(header + 8, (unsigned long long)startMinute, 4);
+    putLittleEndian(header + 12, (unsigned long long)length, 4);
+    putLittleEndian(header + 16, crc32(writer->payload, length), 4);
+    fwrite(header, 1, sizeof(header), writer->file);
+    fwrite(writer->payload, 1, length, writer->file);
+    writer->eventCount = 0;
+    return 1;
+}
+
+/**
+ * Function name: openTraceWriter
+ * Description: Create a binary trace and write its header.
+ * Parameters:
+ *** TraceWriter *writer: Pointer to the trace writer to be initialized.
+ *** const char *path: Path of the trace file.
+ * Return value:
+ *** int: Returns 1 on success, otherwise returns 0.
+ */
+int openTraceWriter(TraceWriter *writer, const char *path) {
+    unsigned char header[5];
+
+    memset(writer, 0, sizeof(*writer));
+    writer->file = fopen(path, "wb");
+    if (writer->file == NULL) {
+        printf("|-[ ! ]- [ Cannot create trace file %s\n", path);
+        return 0;
+    }
+    memcpy(header, TRACE_MAGIC, 4);
+    header[4] = TRACE_VERSION;
+    fwrite(header, 1, sizeof(header), writer->file);
+    return 1;
+}
+
+/**
+ * Function name: writeTraceEvent
+ * Description: Append an arrival or report to the trace. Idle minutes are implied and not written.
+ * Parameters:
+ *** TraceWriter *writer: Pointer to the trace writer.
+ *** const TraceEvent *event: The event, later than every event written before.
+ * Return value:
+ *** int: Returns 1 on success, otherwise returns 0.
+ */
+int writeTraceEvent(TraceWriter *writer, const TraceEvent *event) {
+    if (event->type == TRACE_IDLE) {
+        return 1;
+    }
+    if ((event->type != TRACE_ARRIVAL && event->type != TRACE_REPORT) || event->minute < writer->nextMinute) {
+        printf("|-[ ! ]- [ Trace events must be arrivals or reports in minute order\n");
+        return 0;
+    }
+    if (event->type == TRACE_ARRIVAL && (event->accountType < 0 || event->accountType > 3)) {
+        printf("|-[ ! ]- [ Invalid account type %d at minute %d\n", event->accountType, event->minute);
+        return 0;
+    }
+
+    writer->events[writer->eventCount++] = *event;
+    writer->nextMinute = event->minute + 1;
+    if (writer->eventCount == TRACE_BLOCK_EVENTS) {
+        return writeBlock(writer);
+    }
+    return 1;
+}
+
+/**
+ * Function name: closeTraceWriter
+ * Description: Write the last block, the block index and the footer, then close the trace.
+ * Parameters:
+ *** TraceWriter *writer: Pointer to the trace writer.
+ *** int exitMinute: Minute at which the replay exits.
+ * Return value:
+ *** int: Returns 1 if the whole trace was written, otherwise returns 0.
+ */
+int closeTraceWriter(TraceWriter *writer, int exitMinute) {
+    unsigned char buffer[TRACE_FOOTER];
+    int ok = writeBlock(writer);
+
+    if (exitMinute < writer->nextMinute) {
+        exitMinute = writer->nextMinute;
+    }
+
+    putLittleEndian(buffer, 0, 4);
+    fwrite(buffer, 1, 4, writer->file);
+
+    long long indexOffset = ftell(writer->file);
+    putLittleEndian(buffer, (unsigned long long)writer->blockCount, 4);
+    fwrite(buffer, 1, 4, writer->file);
+    for (int i = 0; i < writer->blockCount; i++) {
+        putLittleEndian(buffer, (unsigned long long)writer->index[i].startMinute, 4);
+        putLittleEndian(buffer + 4, (unsigned long long)writer->index[i].offset, 8);
+        fwrite(buffer, 1, TRACE_INDEX_ENTRY, writer->file);
+    }
+
+    putLittleEndian(buffer, (unsigned long long)exitMinute, 4);
+    putLittleEndian(buffer + 4, (unsigned long long)indexOffset, 8);
+    memcpy(buffer + 12, TRACE_FOOTER_MAGIC, 4);
+    fwrite(buffer, 1, TRACE_FOOTER, writer->file);
+
+    ok = !ferror(writer->file) && ok;
+    ok = fclose(writer->file) == 0 && ok;
+    free(writer->index);
+    writer->file = NULL;
+    writer->index = NULL;
+    if (!ok) {
+        printf("|-[ ! ]- [ Trace was not completely written\n");
+    }
+    return ok;
+}
+
+/**
+ * Function name: openTraceReader
+ * Description: Open a binary trace and load its block index.
+ * Parameters:
+ *** TraceReader *reader: Pointer to the trace reader to be initialized.
+ *** const char *path: Path of the trace file.
+ * Return value:
+ *** int: Returns 1 on success, otherwise returns 0.
+ */
+int openTraceReader(TraceReader *reader, const char *path) {
+    unsigned char buffer[TRACE_FOOTER];
+
+    memset(reader, 0, sizeof(*reader));
+    reader->file = fopen(path, "rb");
+    if (reader->file == NULL) {
+        printf("|-[ ! ]- [ Cannot open trace file %s\n", path);
+        return 0;
+    }
+
+    if (fread(buffer, 1, 5, reader->file) != 5 || memcmp(buffer, TRACE_MAGIC, 4) != 0 || buffer[4] != TRACE_VERSION ||
+        fseek(reader->file, -TRACE_FOOTER, SEEK_END) != 0 ||
+        fread(buffer, 1, TRACE_FOOTER, reader->file) != TRACE_FOOTER || memcmp(buffer + 12, TRACE_FOOTER_MAGIC, 4) != 0) {
+        printf("|-[ ! ]- [ %s is not a trace file\n", path);
+        closeTraceReader(reader);
+        return 0;
+    }
+    reader->exitMinute = (int)getLittleEndian(buffer, 4);
+    long long indexOffset = (long long)getLittleEndian(buffer + 4, 8);
+
+    if (fseek(reader->file, (long)indexOffset, SEEK_SET) != 0 || fread(buffer, 1, 4, reader->file) != 4) {
+        printf("|-[ ! ]- [ Trace index of %s is damaged\n", path);
+        closeTraceReader(reader);
+        return 0;
+    }
+    reader->blockCount = (int)getLittleEndian(buffer, 4);
+    reader->index = malloc((reader->blockCount > 0 ? reader->blockCount : 1) * sizeof(TraceBlock));
+    if (reader->index == NULL) {
+        printf("|-[ ! ]- [ Out of memory for the trace index\n");
+        closeTraceReader(reader);
+        return 0;
+    }
+    for (int i = 0; i < reader->blockCount; i++) {
+        if (fread(buffer, 1, TRACE_INDEX_ENTRY, reader->file) != TRACE_INDEX_ENTRY) {
+            printf("|-[ ! ]- [ Trace index of %s is damaged\n", path);
+            closeTraceReader(reader);
+            return 0;
+        }
+        reader->index[i].startMinute = (int)getLittleEndian(buffer, 4);
+        reader->index[i].offset = (long long)getLittleEndian(buffer + 4, 8);
+    }
+    return 1;
+}
+
+/**
+ * Function name: loadBlock
+ * Description: Read, verify and decode the next block of the trace.
+ * Parameters:
+ *** TraceReader *reader: Pointer to the trace reader.
+ * Return value:
+ *** int: Returns 1 on success, otherwise returns 0.
+ */
+static int loadBlock(TraceReader *reader) {
+    unsigned char header[TRACE_BLOCK_HEADER];
+    TraceBlock *block = &reader->index[reader->nextBlock];
+
+    reader->eventCount = 0;
+    reader->eventIndex = 0;
+    if (fseek(reader->file, (long)block->offset, SEEK_SET) != 0 ||
+        fread(header, 1, sizeof(header), reader->file) != sizeof(header)) {
+        printf("|-[ ! ]- [ Trace block %d is truncated\n", reader->nextBlock);
+        return 0;
+    }
+
+    int events = (int)getLittleEndian(header, 4);
+    int arrivals = (int)getLittleEndian(header + 4, 4);
+    int minute = (int)getLittleEndian(header + 8, 4);
+    int length = (int)getLittleEndian(header + 12, 4);
+    unsigned int checksum = (unsigned int)getLittleEndian(header + 16, 4);
+    if (events <= 0 || events > TRACE_BLOCK_EVENTS || arrivals < 0 || arrivals > events ||
+        length < (arrivals + 3) / 4 || length > TRACE_MAX_PAYLOAD || minute != block->startMinute ||
+        fread(reader->payload, 1, length, reader->file) != (size_t)length) {
+        printf("|-[ ! ]- [ Trace block %d is damaged\n", reader->nextBlock);
+        return 0;
+    }
+    if (crc32(reader->payload, length) != checksum) {
+        printf("|-[ ! ]- [ Trace block %d fails its checksum\n", reader->nextBlock);
+        return 0;
+    }
+
+    int position = (arrivals + 3) / 4;
+    int arrival = 0;
+    for (int i = 0; i < events; i++) {
+        TraceEvent *event = &reader->events[i];
+        unsigned long long value;
+        int used = getVarint(reader->payload + position, length - position, &value);
+        if (used == 0) {
+            printf("|-[ ! ]- [ Trace block %d is damaged\n", reader->nextBlock);
+            return 0;
+        }
+        position += used;
+        event->minute = minute + (int)(value >> 1);
+        event->type = (value & 1) ? TRACE_REPORT : TRACE_ARRIVAL;
+        event->amount = 0;
+        event->accountType = 0;
+        if (event->type == TRACE_ARRIVAL) {
+            used = getVarint(reader->payload + position, length - position, &value);
+            if (used == 0 || arrival == arrivals) {
+                printf("|-[ ! ]- [ Trace block %d is damaged\n", reader->nextBlock);
+                return 0;
+            }
+            position += used;
+            event->amount = (int)zigzagDecode(value);
+            event->accountType = (reader->payload[arrival / 4] >> (2 * (arrival % 4))) & 0x3;
+            arrival++;
+        }
+        minute = event->minute + 1;
+    }
+    // Fewer arrivals than the header counts, or bytes left over, mean the events were misread
+    if (arrival != arrivals || position != length) {
+        printf("|-[ ! ]- [ Trace block %d is damaged\n", reader->nextBlock);
+        return 0;
+    }
+
+    reader->eventCount = events;
+    reader->nextBlock++;
+    return 1;
+}
+
+/**
+ * Function name: seekTrace
+ * Description: Position the reader so that the next event returned is the one of the given minute.
+ * Parameters:
+ *** TraceReader *reader: Pointer to the trace reader.
+ *** int minute: The minute to continue the replay from.
+ * Return value:
+ *** int: Returns 1 on success, otherwise returns 0.
+ */
+int seekTrace(TraceReader *reader, int minute) {
+    // Find the last block starting at or before the minute
+    int low = 0;
+    int high = reader->blockCount - 1;
+    int found = 0;
+    while (low <= high) {
+        int middle = (low + high) / 2;
+        if (reader->index[middle].startMinute <= minute) {
+            found = middle;
+            low = middle + 1;
+        } else {
+            high = middle - 1;
+        }
+    }
+
+    reader->nextBlock = found;
+    reader->eventCount = 0;
+    reader->eventIndex = 0;
+    reader->minute = minute;
+    if (found < reader->blockCount && !loadBlock(reader)) {
+        return 0;
+    }
+    while (reader->eventIndex < reader->eventCount && reader->events[reader->eventIndex].minute < minute) {
+        reader->eventIndex++;
+    }
+    return 1;
+}
+
+/**
+ * Function name: nextTraceEvent
+ * Description: Get the event of the next minute of the replay, loading blocks as they are needed.
+ * Parameters:
+ *** TraceReader *reader: Pointer to the trace reader.
+ *** TraceEvent *event: Pointer to store the event.
+ * Return value:
+ *** int: Returns 1 on success, or 0 if the trace is damaged. A damaged trace returns TRACE_EXIT.
+ */
+int nextTraceEvent(TraceReader *reader, TraceEvent *event) {
+    int ok = 1;
+
+    if (reader->eventIndex == reader->eventCount && reader->nextBlock < reader->blockCount) {
+        ok = loadBlock(reader);
+    }
+
+    memset(event, 0, sizeof(*event));
+    event->minute = reader->minute++;
+    if (!ok || event->minute >= reader->exitMinute) {
+        event->type = TRACE_EXIT;
+    } else if (reader->eventIndex < reader->eventCount && reader->events[reader->eventIndex].minute == event->minute) {
+        *event = reader->events[reader->eventIndex++];
+    } else {
+        event->type = TRACE_IDLE;
+    }
+    return ok;
+}
+
+/**
+ * Function name: closeTraceReader
+ * Description: Close the trace file and free the block index.
+ * Parameters:
+ *** TraceReader *reader: Pointer to the trace reader.
+ */
+void closeTraceReader(TraceReader *reader) {
+    if (reader->file != NULL) {
+        fclose(reader->file);
+        reader->file = NULL;
+    }
+    free(reader->index);
+    reader->index = NULL;
+}
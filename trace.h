@@ -0,0 +1,83 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <stdio.h>
+#include "encoding.h"
+
+// Define the number of events per block
+#define TRACE_BLOCK_EVENTS 4096
+#define TRACE_MAX_PAYLOAD (TRACE_BLOCK_EVENTS * 2 * MAX_VARINT_BYTES + TRACE_BLOCK_EVENTS / 4)
+
+// Define the trace events, numbered like the menu choices they replay
+#define TRACE_IDLE 0
+#define TRACE_ARRIVAL 1
+#define TRACE_REPORT 2
+#define TRACE_EXIT 3
+
+/*
+ * Binary layout, all fixed size integers little-endian:
+ *
+ *   header:  "CCTR", u8 version
+ *   block:   u32 event count (at most TRACE_BLOCK_EVENTS), u32 arrival count, u32 start minute,
+ *            u32 payload length, u32 CRC-32 of the payload, payload
+ *   payload: account types packed 2 bits per arrival, first arrival in the low bits,
+ *            then per event varint((minutes since the previous event << 1) | is report),
+ *            followed by the zigzag varint amount for arrivals
+ *   end:     u32 0
+ *   index:   u32 block count, block count x (u32 start minute, u64 file offset)
+ *   footer:  u32 exit minute, u64 index offset, "CCTE"
+ *
+ * A block counts minutes from its start minute, so every block can be decoded on its own.
+ * Minutes without an event are idle, the trace exits at the exit minute.
+ */
+
+// Define one minute of a trace
+typedef struct {
+    int minute;
+    int type;          // TRACE_IDLE, TRACE_ARRIVAL, TRACE_REPORT or TRACE_EXIT
+    int amount;        // Only for arrivals
+    int accountType;   // Only for arrivals
+} TraceEvent;
+
+// Define a block index entry
+typedef struct {
+    int startMinute;
+    long long offset;
+} TraceBlock;
+
+// Define a writer that buffers one block of events at a time
+typedef struct {
+    FILE *file;
+    TraceEvent events[TRACE_BLOCK_EVENTS];
+    int eventCount;
+    int nextMinute;            // First minute the next event may use
+    TraceBlock *index;
+    int blockCount;
+    int indexCapacity;
+    unsigned char payload[TRACE_MAX_PAYLOAD];
+} TraceWriter;
+
+// Define a reader that decodes one block at a time
+typedef struct {
+    FILE *file;
+    TraceBlock *index;
+    int blockCount;
+    int exitMinute;
+    int nextBlock;             // Next block to load
+    TraceEvent events[TRACE_BLOCK_EVENTS];
+    int eventCount;
+    int eventIndex;            // Next decoded event to replay
+    int minute;                // Minute returned by the next call of nextTraceEvent
+    unsigned char payload[TRACE_MAX_PAYLOAD];
+} TraceReader;
+
+// Function declarations
+int openTraceWriter(TraceWriter *writer, const char *path);
+int writeTraceEvent(TraceWriter *writer, const TraceEvent *event);
+int closeTraceWriter(TraceWriter *writer, int exitMinute);
+int openTraceReader(TraceReader *reader, const char *path);
+int seekTrace(TraceReader *reader, int minute);
+int nextTraceEvent(TraceReader *reader, TraceEvent *event);
+void closeTraceReader(TraceReader *reader);
+
+#endif // TRACE_H
@@ -0,0 +1,131 @@
+#include <stdio.h>
+#include <string.h>
+#include "trace.h"
+
+/**
+ * Function name: readNumber
+ * Description: Read the next integer of a text trace, counting the lines passed on the way.
+ * Parameters:
+ *** FILE *text: The text trace.
+ *** int *value: Pointer to store the integer.
+ *** int *line: Line number, advanced past every newline skipped.
+ * Return value:
+ *** int: Returns 1 if an integer was read, 0 at the end of the input, or -1 if something else comes next.
+ */
+static int readNumber(FILE *text, int *value, int *line) {
+    int c;
+    while ((c = getc(text)) != EOF && (c == ' ' || c == '\t' || c == '\r' || c == '\n')) {
+        *line += c == '\n';
+    }
+    if (c == EOF) {
+        return 0;
+    }
+    ungetc(c, text);
+    return fscanf(text, "%d", value) == 1 ? 1 : -1;
+}
+
+/**
+ * Function name: encodeTrace
+ * Description: Convert a text trace (the menu choices typed into the simulator) into a binary trace.
+ *              A malformed text trace is reported with its line and no binary trace is left behind.
+ * Parameters:
+ *** FILE *text: The text trace.
+ *** const char *tracePath: Path of the binary trace to create.
+ * Return value:
+ *** int: Returns 0 on success, otherwise returns 1.
+ */
+int encodeTrace(FILE *text, const char *tracePath) {
+    static TraceWriter writer;
+    int minute = 0;
+    int line = 1;
+    int choice;
+    int status;
+
+    if (!openTraceWriter(&writer, tracePath)) {
+        return 1;
+    }
+
+    // Every menu choice takes one minute, the trace ends at the first exit or at the end of the input
+    while ((status = readNumber(text, &choice, &line)) == 1 && choice != TRACE_EXIT) {
+        TraceEvent event = { minute, TRACE_IDLE, 0, 0 };
+        if (choice == TRACE_ARRIVAL) {
+            int arrivalLine = line;
+            if (readNumber(text, &event.amount, &line) != 1 || readNumber(text, &event.accountType, &line) != 1) {
+                printf("|-[ ! ]- [ Arrival on line %d of the text trace has no amount and account type\n", arrivalLine);
+                status = -2; // Already reported, with the line the arrival started on
+                break;
+            }
+            event.type = TRACE_ARRIVAL;
+        } else if (choice == TRACE_REPORT) {
+            event.type = TRACE_REPORT;
+        }
+        if (!writeTraceEvent(&writer, &event)) {
+            closeTraceWriter(&writer, minute);
+            return 1;
+        }
+        minute++;
+    }
+    if (status < 0) {
+        if (status == -1) {
+            printf("|-[ ! ]- [ Line %d of the text trace is not a menu choice\n", line);
+        }
+        closeTraceWriter(&writer, minute);
+        remove(tracePath);
+        return 1;
+    }
+    return closeTraceWriter(&writer, minute) ? 0 : 1;
+}
+
+/**
+ * Function name: decodeTrace
+ * Description: Convert a binary trace back into a text trace, writing 0 for idle minutes.
+ * Parameters:
+ *** const char *tracePath: Path of the binary trace.
+ *** FILE *text: Destination of the text trace.
+ * Return value:
+ *** int: Returns 0 on success, otherwise returns 1.
+ */
+int decodeTrace(const char *tracePath, FILE *text) {
+    static TraceReader reader;
+    TraceEvent event;
+    int ok = 1;
+
+    if (!openTraceReader(&reader, tracePath)) {
+        return 1;
+    }
+    do {
+        ok = nextTraceEvent(&reader, &event);
+        if (event.type == TRACE_ARRIVAL) {
+            fprintf(text, "%d\n%d %d\n", TRACE_ARRIVAL, event.amount, event.accountType);
+        } else {
+            fprintf(text, "%d\n", event.type);
+        }
+    } while (event.type != TRACE_EXIT);
+    closeTraceReader(&reader);
+    return ok ? 0 : 1;
+}
+
+int main(int argc, char *argv[]) {
+    if (argc == 4 && strcmp(argv[1], "encode") == 0) {
+        if (strcmp(argv[2], "-") != 0 && freopen(argv[2], "r", stdin) == NULL) {
+            printf("|-[ ! ]- [ Cannot open text trace %s\n", argv[2]);
+            return 1;
+        }
+        return encodeTrace(stdin, argv[3]);
+    }
+    if (argc == 4 && strcmp(argv[1], "decode") == 0) {
+        FILE *text = strcmp(argv[3], "-") == 0 ? stdout : fopen(argv[3], "w");
+        if (text == NULL) {
+            printf("|-[ ! ]- [ Cannot create text trace %s\n", argv[3]);
+            return 1;
+        }
+        int status = decodeTrace(argv[2], text);
+        if (text != stdout && fclose(text) != 0) {
+            status = 1;
+        }
+        return status;
+    }
+    printf("Usage: %s encode <text trace|-> <binary trace>\n"
+           "       %s decode <binary trace> <text trace|->\n", argv[0], argv[0]);
+    return 1;
+}
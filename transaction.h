@@ -7,6 +7,8 @@ typedef struct {
     int amount;
     int accountType;
     int duration;
+    int arrivalTime; // Minute the customer arrived
+    int timerHandle; // Patience timer while the customer waits, -1 if none
 } Transaction;
 
 #endif // TRANSACTION_H
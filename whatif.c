@@ -0,0 +1,371 @@
+#include "whatif.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static const char *typeKeys[NUM_ACCOUNT_TYPES] = { "new", "gov", "checking", "savings" };
+
+/**
+ * Function name: parseType
+ * Description: Look up the account type named in a variant key.
+ * Parameters:
+ *** const char *name: The type name, for example gov.
+ * Return value:
+ *** int: The account type, or -1 if the name is unknown.
+ */
+static int parseType(const char *name) {
+    for (int type = 0; type < NUM_ACCOUNT_TYPES; type++) {
+        if (strcmp(name, typeKeys[type]) == 0) {
+            return type;
+        }
+    }
+    return -1;
+}
+
+/**
+ * Function name: parseChange
+ * Description: Apply one key=value change of a variant to a set of parameters.
+ * Parameters:
+ *** char *change: The change, modified while parsing.
+ *** BankParams *params: The parameters to change.
+ * Return value:
+ *** int: Returns 1 on success, otherwise returns 0.
+ */
+static int parseChange(char *change, BankParams *params) {
+    char *value = strchr(change, '=');
+    char *end;
+    if (value == NULL) {
+        return 0;
+    }
+    *value++ = '\0';
+
+    if (strncmp(change, "limit.", 6) == 0) {
+        int type = parseType(change + 6);
+        long limit = strtol(value, &end, 10);
+        if (type < 0 || *end != '\0' || limit < 1 || limit > MAX_QUEUE_SIZE) {
+            return 0;
+        }
+        params->queueLimit[type] = (int)limit;
+    } else if (strncmp(change, "duration.", 9) == 0) {
+        int type = parseType(change + 9);
+        long min = strtol(value, &end, 10);
+        if (type < 0 || *end != '-') {
+            return 0;
+        }
+        long max = strtol(end + 1, &end, 10);
+        if (*end != '\0' || min < 1 || max < min || max > 1000) {
+            return 0;
+        }
+        params->minDuration[type] = (int)min;
+        params->maxDuration[type] = (int)max;
+    } else if (strcmp(change, "policy") == 0) {
+        const ScalingPolicy *policy = findScalingPolicy(value);
+        if (policy == NULL) {
+            return 0;
+        }
+        params->scaling = *policy;
+        end = value + strlen(value);
+    } else if (strcmp(change, "open-wait") == 0) {
+        params->scaling.openWait = strtod(value, &end);
+    } else if (strcmp(change, "close-wait") == 0) {
+        params->scaling.closeWait = strtod(value, &end);
+    } else if (strcmp(change, "smoothing") == 0) {
+        params->scaling.smoothing = strtod(value, &end);
+    } else if (strcmp(change, "min-open") == 0) {
+        params->scaling.minOpenTime = (int)strtol(value, &end, 10);
+    } else if (strcmp(change, "pending-trigger") == 0) {
+        params->scaling.pendingTrigger = (int)strtol(value, &end, 10);
+    } else {
+        return 0;
+    }
+    return *end == '\0' && end != value;
+}
+
+/**
+ * Function name: parseVariant
+ * Description: Build the parameters of a variant from the baseline parameters and a list of changes.
+ * Parameters:
+ *** const char *spec: The changes, see whatif.h.
+ *** const BankParams *base: The baseline parameters.
+ *** BankParams *params: Pointer to store the parameters of the variant.
+ * Return value:
+ *** int: Returns 1 on success, otherwise returns 0.
+ */
+int parseVariant(const char *spec, const BankParams *base, BankParams *params) {
+    char buffer[256];
+    *params = *base;
+    if (strlen(spec) >= sizeof(buffer)) {
+        printf("|-[ ! ]- [ Variant is too long: %s\n", spec);
+        return 0;
+    }
+    strcpy(buffer, spec);
+    for (char *change = strtok(buffer, ","); change != NULL; change = strtok(NULL, ",")) {
+        char shown[sizeof(buffer)];
+        strcpy(shown, change);
+        if (!parseChange(change, params)) {
+            printf("|-[ ! ]- [ Invalid change %s in variant %s\n", shown, spec);
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/**
+ * Function name: earlier
+ * Description: Get the earlier of two minutes, where BANK_NEVER comes after every minute.
+ * Parameters:
+ *** int a: A minute or BANK_NEVER.
+ *** int b: A minute or BANK_NEVER.
+ * Return value:
+ *** int: The earlier minute.
+ */
+static int earlier(int a, int b) {
+    if (a == BANK_NEVER) {
+        return b;
+    }
+    return b == BANK_NEVER || a < b ? a : b;
+}
+
+/**
+ * Function name: parameterDivergence
+ * Description: Find the first minute of the baseline at which a changed queue limit or duration range
+ *              was consulted. Until then the variant behaves exactly like the baseline.
+ * Parameters:
+ *** const Bank *baseline: The bank at the end of the baseline run.
+ *** const BankParams *params: The parameters of the variant.
+ * Return value:
+ *** int: The minute, or BANK_NEVER if no changed parameter was ever consulted.
+ */
+static int parameterDivergence(const Bank *baseline, const BankParams *params) {
+    int minute = BANK_NEVER;
+    for (int type = 0; type < NUM_ACCOUNT_TYPES; type++) {
+        int oldLimit = baseline->params.queueLimit[type];
+        int newLimit = params->queueLimit[type];
+        if (oldLimit != newLimit) {
+            // isQueueFull answers differently for every queue size from the lower limit up to the higher one
+            int low = oldLimit < newLimit ? oldLimit : newLimit;
+            int high = oldLimit < newLimit ? newLimit : oldLimit;
+            for (int size = low; size < high; size++) {
+                minute = earlier(minute, baseline->firstLimitCheck[type][size]);
+            }
+        }
+        if (baseline->params.minDuration[type] != params->minDuration[type] ||
+            baseline->params.maxDuration[type] != params->maxDuration[type]) {
+            minute = earlier(minute, baseline->firstDuration[type]);
+        }
+    }
+    return minute;
+}
+
+/**
+ * Function name: scalingDiverges
+ * Description: Check whether the scaling policy of a variant could act differently on this minute's signals.
+ * Parameters:
+ *** const ScalingPolicy *base: The baseline policy.
+ *** const ScalingPolicy *policy: The policy of the variant.
+ *** const ScalingSignals *signals: The signals the baseline decided on.
+ * Return value:
+ *** int: Returns 1 if the variant could diverge at this minute, otherwise returns 0.
+ */
+static int scalingDiverges(const ScalingPolicy *base, const ScalingPolicy *policy, const ScalingSignals *signals) {
+    // A different smoothing weight only changes the smoothed depth once the depth is not zero
+    if (policy->smoothing != base->smoothing && signals->depth != 0) {
+        return 1;
+    }
+    return policy->decide(policy, signals) != base->decide(base, signals);
+}
+
+/**
+ * Function name: simulateMinute
+ * Description: Replay one minute of the trace.
+ * Parameters:
+ *** Bank *bank: Pointer to the bank.
+ *** TraceReader *trace: Pointer to the trace reader.
+ * Return value:
+ *** int: Returns 1 if a minute was simulated, 0 once the trace exits, or -1 if the trace is damaged.
+ */
+static int simulateMinute(Bank *bank, TraceReader *trace) {
+    TraceEvent event;
+    if (!nextTraceEvent(trace, &event)) {
+        return -1;
+    }
+    if (event.type == TRACE_EXIT) {
+        return 0;
+    }
+    if (event.type == TRACE_ARRIVAL) {
+        addCustomer(bank, event.amount, event.accountType);
+    }
+    tickBank(bank);
+    return 1;
+}
+
+/**
+ * Function name: summarize
+ * Description: Collect the outcome of a simulation.
+ * Parameters:
+ *** const Bank *bank: Pointer to the bank at the end of the simulation.
+ *** WhatIfResult *result: Pointer to store the outcome.
+ */
+static void summarize(const Bank *bank, WhatIfResult *result) {
+    int served = 0;
+    memset(result, 0, sizeof(*result));
+    result->minutes = bank->totalTimeElapsed;
+    result->arrivals = bank->stubNumber - 1;
+    result->rejected = bank->rejected;
+    for (int i = 0; i < NUM_TELLERS; i++) {
+        result->completed += bank->completedCount[i];
+        served += bank->completedCount[i] + bank->isBusy[i];
+    }
+    for (int type = 0; type < NUM_ACCOUNT_TYPES; type++) {
+        result->balked += bank->balked[type];
+        result->reneged += bank->reneged[type];
+    }
+    result->averageWait = served > 0 ? (double)bank->totalWait / served : 0.0;
+}
+
+/**
+ * Function name: printResult
+ * Description: Print the outcome of one simulation.
+ * Parameters:
+ *** const char *name: Name of the simulation.
+ *** const WhatIfResult *result: Pointer to the outcome.
+ */
+static void printResult(const char *name, const WhatIfResult *result) {
+    printf("|-[ %s ]-[ Arrivals: %d | Completed: %d | Average wait: %.2f minutes | Balked: %d | Reneged: %d | Rejected: %d\n",
+           name, result->arrivals, result->completed, result->averageWait, result->balked, result->reneged, result->rejected);
+}
+
+/**
+ * Function name: runWhatIf
+ * Description: Replay a trace once as the baseline while keeping a snapshot of the bank every interval
+ *              minutes, then rerun each variant from the last snapshot before its changes can matter.
+ * Parameters:
+ *** Bank *bank: Pointer to the bank, set up with the baseline parameters.
+ *** TraceReader *trace: Pointer to the trace reader, positioned at minute 0.
+ *** const char **specs: The variants, see whatif.h.
+ *** int count: Number of variants.
+ *** int interval: Minutes between two snapshots.
+ * Return value:
+ *** int: Returns 0 on success, otherwise returns 1.
+ */
+int runWhatIf(Bank *bank, TraceReader *trace, const char **specs, int count, int interval) {
+    static WhatIfVariant variants[WHATIF_MAX_VARIANTS];
+    static Bank work;
+    BankSnapshot *snapshots = NULL;
+    int snapshotCount = 0;
+    int snapshotCapacity = 0;
+    int status = 0;
+    WhatIfResult baseline;
+
+    if (count > WHATIF_MAX_VARIANTS || interval < 1) {
+        printf("|-[ ! ]- [ At most %d variants and a snapshot interval of at least 1 minute\n", WHATIF_MAX_VARIANTS);
+        return 1;
+    }
+    for (int v = 0; v < count; v++) {
+        variants[v].spec = specs[v];
+        variants[v].divergeMinute = BANK_NEVER;
+        if (!parseVariant(specs[v], &bank->params, &variants[v].params)) {
+            return 1;
+        }
+    }
+
+    // Baseline run, snapshotting the bank at the start of every interval
+    bank->completedTransactions = NULL; // Never read here, and the snapshots stay smaller without them
+    do {
+        int minute = bank->totalTimeElapsed;
+        if (minute % interval == 0) {
+            if (snapshotCount == snapshotCapacity) {
+                int capacity = snapshotCapacity > 0 ? snapshotCapacity * 2 : 16;
+                BankSnapshot *grown = realloc(snapshots, capacity * sizeof(BankSnapshot));
+                if (grown == NULL) {
+                    printf("|-[ ! ]- [ Out of memory for snapshots\n");
+                    status = 1;
+                    break;
+                }
+                snapshots = grown;
+                snapshotCapacity = capacity;
+            }
+            memset(&snapshots[snapshotCount], 0, sizeof(BankSnapshot));
+            snapshots[snapshotCount].minute = minute;
+            if (!copyBank(&snapshots[snapshotCount].bank, bank)) {
+                printf("|-[ ! ]- [ Out of memory for snapshots\n");
+                status = 1;
+                break;
+            }
+            snapshotCount++;
+        }
+        int simulated = simulateMinute(bank, trace);
+        if (simulated < 0) {
+            printf("|-[ ! ]- [ Baseline stopped at minute %d, the rest of the trace is unreadable\n", minute);
+            status = 1;
+        }
+        if (simulated <= 0) {
+            break;
+        }
+        for (int v = 0; v < count; v++) {
+            if (variants[v].divergeMinute == BANK_NEVER &&
+                scalingDiverges(&bank->params.scaling, &variants[v].params.scaling, &bank->signals)) {
+                variants[v].divergeMinute = minute;
+            }
+        }
+    } while (1);
+    summarize(bank, &baseline);
+
+    if (status == 0) {
+        printf("|================================================[ WHAT-IF ANALYSIS ]================================================|\n");
+        printResult("baseline", &baseline);
+    }
+
+    // Each variant resumes from the last snapshot taken before it diverges
+    long long simulated = 0;
+    for (int v = 0; v < count && status == 0; v++) {
+        WhatIfVariant *variant = &variants[v];
+        variant->divergeMinute = earlier(variant->divergeMinute, parameterDivergence(bank, &variant->params));
+        if (variant->divergeMinute == BANK_NEVER) {
+            variant->resumeMinute = baseline.minutes;
+            variant->result = baseline; // Nothing it changes was ever consulted
+        } else {
+            int s = snapshotCount - 1;
+            while (s > 0 && snapshots[s].minute > variant->divergeMinute) {
+                s--;
+            }
+            variant->resumeMinute = snapshots[s].minute;
+            if (!copyBank(&work, &snapshots[s].bank) || !seekTrace(trace, variant->resumeMinute)) {
+                printf("|-[ ! ]- [ Cannot resume variant %s\n", variant->spec);
+                status = 1;
+                break;
+            }
+            setBankParams(&work, &variant->params);
+            int step;
+            while ((step = simulateMinute(&work, trace)) > 0) {
+            }
+            if (step < 0) {
+                printf("|-[ ! ]- [ Variant %s stopped at minute %d, the rest of the trace is unreadable\n",
+                       variant->spec, work.totalTimeElapsed);
+                status = 1;
+                break;
+            }
+            summarize(&work, &variant->result);
+        }
+        simulated += variant->result.minutes - variant->resumeMinute;
+        printResult(variant->spec, &variant->result);
+        if (variant->divergeMinute == BANK_NEVER) {
+            printf("|-[ ! ]-[ No change takes effect, same as the baseline\n");
+        } else {
+            printf("|-[ ! ]-[ Diverges at minute %d, resumed from minute %d, simulated %d of %d minutes\n",
+                   variant->divergeMinute, variant->resumeMinute, variant->result.minutes - variant->resumeMinute,
+                   variant->result.minutes);
+        }
+    }
+    if (status == 0) {
+        printf("|-[ ! ]-[ Simulated %lld minutes for %d variants instead of %lld for full reruns\n",
+               simulated, count, (long long)count * baseline.minutes);
+    }
+
+    for (int s = 0; s < snapshotCount; s++) {
+        freeBank(&snapshots[s].bank);
+    }
+    free(snapshots);
+    freeBank(&work);
+    return status;
+}
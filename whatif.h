@@ -0,0 +1,54 @@
+#ifndef WHATIF_H
+#define WHATIF_H
+
+#include "bank.h"
+#include "trace.h"
+
+// Define the what-if limits
+#define WHATIF_MAX_VARIANTS 64
+#define WHATIF_DEFAULT_INTERVAL 60
+
+/*
+ * A variant is a comma separated list of parameter changes, for example
+ * "limit.new=4,duration.gov=8-12,open-wait=15". The keys are:
+ *
+ *   limit.<type>=N          queue size from which isQueueFull reports full for that type
+ *   duration.<type>=MIN-MAX range of getRandomDuration
+ *   policy=adaptive|legacy  scaling policy
+ *   open-wait=X, close-wait=X, min-open=N, smoothing=X, pending-trigger=N
+ *                           scaling policy parameters
+ *
+ * where <type> is new, gov, checking or savings.
+ */
+
+// Define the state of the bank at the start of a minute
+typedef struct {
+    int minute;
+    Bank bank;
+} BankSnapshot;
+
+// Define the outcome of one simulation
+typedef struct {
+    int minutes;
+    int arrivals;
+    int completed;
+    int balked;
+    int reneged;
+    int rejected;
+    double averageWait;
+} WhatIfResult;
+
+// Define a variant and how much of the baseline it could reuse
+typedef struct {
+    const char *spec;
+    BankParams params;
+    int divergeMinute;      // First minute the changes can make a difference, or BANK_NEVER
+    int resumeMinute;       // Minute of the snapshot the variant resumed from
+    WhatIfResult result;
+} WhatIfVariant;
+
+// Function declarations
+int parseVariant(const char *spec, const BankParams *base, BankParams *params);
+int runWhatIf(Bank *bank, TraceReader *trace, const char **specs, int count, int interval);
+
+#endif // WHATIF_H